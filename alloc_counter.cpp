@@ -0,0 +1,36 @@
+/*------------------------------------------------------------------------------
+  File:        alloc_counter.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Counting replacements for the global operator new/delete
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+  -----------------------------------------------------------------------------*/
+#include "alloc_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> allocations(0);
+
+uint64_t heapAllocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+// The array and nothrow forms forward here by default
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
@@ -0,0 +1,27 @@
+/*------------------------------------------------------------------------------
+  File:        alloc_counter.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the heap allocation counter reported by --stats
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               alloc_counter.cpp replaces the global operator new so every
+               heap allocation in the program is counted. Only link it into
+               tools that want the number.
+
+  Dependencies:
+    - <cstdint>
+  -----------------------------------------------------------------------------*/
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+// Calls to operator new (plain, array and nothrow) since the program started
+uint64_t heapAllocationCount();
+
+#endif // ALLOC_COUNTER_H
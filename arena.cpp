@@ -0,0 +1,31 @@
+/*------------------------------------------------------------------------------
+  File:        arena.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements block refills for the bump allocator
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+  -----------------------------------------------------------------------------*/
+#include "arena.h"
+
+using namespace std;
+
+Arena::Arena(size_t blockBytes)
+    : blockBytes(blockBytes), cursor(nullptr), end(nullptr) { }
+
+void* Arena::allocateSlow(size_t bytes, size_t alignment) {
+    size_t needed = bytes + alignment;
+    if (needed > blockBytes) {
+        // Oversized request gets its own block; keep filling the current one
+        blocks.emplace_back(new char[needed]);
+        char* start = blocks.back().get();
+        return start + (alignment - reinterpret_cast<size_t>(start) % alignment) % alignment;
+    }
+
+    blocks.emplace_back(new char[blockBytes]);
+    cursor = blocks.back().get();
+    end = cursor + blockBytes;
+    return allocate(bytes, alignment);
+}
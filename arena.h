@@ -0,0 +1,78 @@
+/*------------------------------------------------------------------------------
+  File:        arena.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the bump allocator that holds parser data for the
+               length of one assembly run.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Memory is handed out from large blocks by moving a cursor, so
+               thousands of small operand lists cost one heap allocation per
+               block instead of one each. Nothing is freed individually; the
+               whole arena is released when it is destroyed. Only trivially
+               destructible types may be stored.
+
+  Dependencies:
+    - <vector>, <memory>, <cstddef>, <type_traits>, <new>
+  -----------------------------------------------------------------------------*/
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+#include <new>
+
+class Arena {
+public:
+    explicit Arena(size_t blockBytes = 64 * 1024);
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Reserves uninitialized, suitably aligned memory.
+     *
+     * @param bytes     - Size of the allocation
+     * @param alignment - Required alignment (power of two)
+     * @return Pointer valid until the arena is destroyed
+     */
+    void* allocate(size_t bytes, size_t alignment) {
+        size_t padding = (alignment - reinterpret_cast<size_t>(cursor) % alignment) % alignment;
+        if (cursor == nullptr || static_cast<size_t>(end - cursor) < bytes + padding)
+            return allocateSlow(bytes, alignment);
+        char* result = cursor + padding;
+        cursor = result + bytes;
+        return result;
+    }
+
+    // Array of count default-constructed elements
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena memory is never destructed");
+        T* items = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        for (size_t i = 0; i < count; ++i)
+            new (items + i) T();
+        return items;
+    }
+
+    // Number of blocks obtained from the heap so far
+    size_t blockCount() const { return blocks.size(); }
+
+private:
+    // Starts a new block (or a dedicated one for oversized requests)
+    void* allocateSlow(size_t bytes, size_t alignment);
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t blockBytes;
+    char* cursor;
+    char* end;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,232 @@
+/*------------------------------------------------------------------------------
+  File:        assembly_cache.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements the sidecar cache used for incremental re-assembly.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - assembly_cache.h, encoder.h, converters.h, source_scanner.h
+    - <fstream>, <cstring>, <cstdio>, <stdexcept>
+  -----------------------------------------------------------------------------*/
+#include "assembly_cache.h"
+#include "encoder.h"
+#include "converters.h"
+#include "source_scanner.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <stdexcept>
+
+using namespace std;
+
+static const char CACHE_MAGIC[4] = {'T', 'M', 'I', 'C'};
+// Free slot in AssemblyCache::byHash
+static const uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+
+// File layout: header, count 64-bit hashes, count words, then symbolCount
+// entries of address, name length and name (all in host byte order)
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t symbolCount;
+};
+
+uint64_t hashInstruction(const TokenView& token) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](string_view text) {
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        // Separator so "ab c" and "a bc" differ
+        hash ^= 0xFF;
+        hash *= 1099511628211ull;
+    };
+    mix(token.op);
+    for (size_t i = 0; i < token.argCount; ++i)
+        mix(token.args[i]);
+    return hash;
+}
+
+AssemblyCache::AssemblyCache()
+    : cachedHashes(nullptr), cachedWords(nullptr), count(0), shift(0) { }
+
+AssemblyCache::~AssemblyCache() = default;
+
+bool AssemblyCache::load(const string& path) {
+    try {
+        file.reset(new MappedSource(path));
+    } catch (const exception&) {
+        return false;
+    }
+    string_view data = file->view();
+
+    CacheHeader header{};
+    bool valid = data.size() >= sizeof(header);
+    if (valid) {
+        memcpy(&header, data.data(), sizeof(header));
+        valid = memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0
+             && header.version == ASSEMBLY_CACHE_VERSION
+             && sizeof(header) + uint64_t(header.count) * 12 <= data.size();
+    }
+    // The mapping is page aligned and the header is 16 bytes, so both
+    // arrays are naturally aligned where they sit
+    size_t offset = sizeof(header);
+    if (valid) {
+        count = header.count;
+        cachedHashes = reinterpret_cast<const uint64_t*>(data.data() + offset);
+        offset += count * sizeof(uint64_t);
+        cachedWords = reinterpret_cast<const uint32_t*>(data.data() + offset);
+        offset += count * sizeof(uint32_t);
+    }
+    for (uint32_t i = 0; valid && i < header.symbolCount; ++i) {
+        uint32_t entry[2];
+        if (offset + sizeof(entry) > data.size()) {
+            valid = false;
+            break;
+        }
+        memcpy(entry, data.data() + offset, sizeof(entry));
+        offset += sizeof(entry);
+        if (entry[1] > data.size() - offset) {
+            valid = false;
+            break;
+        }
+        cachedLabels.set(string_view(data.data() + offset, entry[1]), entry[0]);
+        offset += entry[1];
+    }
+
+    if (!valid) {
+        cachedHashes = nullptr;
+        cachedWords = nullptr;
+        count = 0;
+        cachedLabels = LabelTable();
+        file.reset();
+    }
+    return valid;
+}
+
+void AssemblyCache::save(const string& path, const vector<uint64_t>& hashes,
+                         const vector<uint32_t>& words, const LabelTable& labels) {
+    // Written beside the old cache and renamed over it, so an interrupted
+    // run never leaves a half-written cache behind
+    string tempPath = path + ".tmp";
+    ofstream out(tempPath, ios::binary);
+    if (!out) {
+        throw runtime_error("Cannot open cache file: " + tempPath);
+    }
+    unordered_map<string, uint32_t> symbols = labels.toMap();
+    CacheHeader header{};
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = ASSEMBLY_CACHE_VERSION;
+    header.count = static_cast<uint32_t>(words.size());
+    header.symbolCount = static_cast<uint32_t>(symbols.size());
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(hashes.data()),
+              static_cast<streamsize>(hashes.size() * sizeof(uint64_t)));
+    out.write(reinterpret_cast<const char*>(words.data()),
+              static_cast<streamsize>(words.size() * sizeof(uint32_t)));
+    for (const auto& symbol : symbols) {
+        uint32_t entry[2] = {symbol.second, static_cast<uint32_t>(symbol.first.size())};
+        out.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+        out.write(symbol.first.data(), static_cast<streamsize>(symbol.first.size()));
+    }
+    out.close();
+    if (!out || rename(tempPath.c_str(), path.c_str()) != 0) {
+        remove(tempPath.c_str());
+        throw runtime_error("Failed writing cache file: " + path);
+    }
+}
+
+size_t AssemblyCache::assemble(const vector<TokenView>& tokens, uint32_t basePc,
+                               const LabelTable& labels, vector<uint32_t>& words,
+                               vector<uint64_t>& hashes) {
+    size_t reused = 0;
+    uint32_t pc = basePc;
+    for (const TokenView& token : tokens) {
+        uint64_t hash = hashInstruction(token);
+        long index = findReusable(token, hash, pc, labels);
+        if (index >= 0) {
+            words.push_back(cachedWords[static_cast<size_t>(index)]);
+            ++reused;
+        } else {
+            words.push_back(encodeInstruction(token, pc, labels));
+        }
+        hashes.push_back(hash);
+        pc += 4;
+    }
+    return reused;
+}
+
+long AssemblyCache::findReusable(const TokenView& token, uint64_t hash, uint32_t pc,
+                                 const LabelTable& labels) {
+    if (count == 0)
+        return -1;
+
+    // Same offset as the last reused line, which follows inserted or deleted lines
+    long position = static_cast<long>(pc / 4);
+    long expected = position + shift;
+    if (expected >= 0 && expected < static_cast<long>(count)
+            && cachedHashes[static_cast<size_t>(expected)] == hash
+            && targetUnchanged(token, static_cast<size_t>(expected), pc, labels))
+        return expected;
+
+    // Otherwise the first copy of the line anywhere in the cache
+    if (byHash.empty())
+        buildIndex();
+    size_t mask = byHash.size() - 1;
+    for (size_t slot = static_cast<size_t>(hash) & mask; byHash[slot] != EMPTY_SLOT;
+            slot = (slot + 1) & mask) {
+        uint32_t index = byHash[slot];
+        if (cachedHashes[index] != hash)
+            continue;
+        if (!targetUnchanged(token, index, pc, labels))
+            return -1;
+        shift = static_cast<long>(index) - position;
+        return index;
+    }
+    return -1;
+}
+
+// Open-addressing table holding the first cached index of each distinct
+// hash, at most half full
+void AssemblyCache::buildIndex() {
+    size_t slots = 16;
+    while (slots < count * 2)
+        slots *= 2;
+    byHash.assign(slots, EMPTY_SLOT);
+    size_t mask = slots - 1;
+    for (size_t i = 0; i < count; ++i) {
+        size_t slot = static_cast<size_t>(cachedHashes[i]) & mask;
+        while (byHash[slot] != EMPTY_SLOT && cachedHashes[byHash[slot]] != cachedHashes[i])
+            slot = (slot + 1) & mask;
+        if (byHash[slot] == EMPTY_SLOT)
+            byHash[slot] = static_cast<uint32_t>(i);
+    }
+}
+
+bool AssemblyCache::targetUnchanged(const TokenView& token, size_t index, uint32_t pc,
+                                    const LabelTable& labels) const {
+    Mnemonic mnemonic = lookupMnemonic(token.op);
+    // Every other word depends on the text alone
+    if (mnemonic != Mnemonic::Beq && mnemonic != Mnemonic::J)
+        return true;
+    if (token.argCount == 0)
+        return false;
+
+    string_view label = token.args[token.argCount - 1];
+    const uint32_t* address = labels.find(label);
+    const uint32_t* cachedAddress = cachedLabels.find(label);
+    if (!address || !cachedAddress)
+        return false;
+    if (mnemonic == Mnemonic::J)
+        return *address == *cachedAddress;
+    // beq encodes the distance from its own address
+    uint32_t cachedPc = static_cast<uint32_t>(index * 4);
+    return *address - pc == *cachedAddress - cachedPc;
+}
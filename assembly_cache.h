@@ -0,0 +1,122 @@
+/*------------------------------------------------------------------------------
+  File:        assembly_cache.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the sidecar cache used for incremental re-assembly.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               After a run, the hash of every instruction's text, its encoded
+               word and the label table are saved next to the output. The
+               next run still parses the whole source but only re-encodes an
+               instruction if its text is new, or if it is a beq or j whose
+               target moved relative to it: a beq keeps its word while the
+               label stays the same distance away, and a j while the label
+               keeps its address.
+
+               Hashes cover the operation and operands only, so edits to
+               comments, labels or spacing do not invalidate a line. Cached
+               words are looked up at the expected position first (following
+               inserted or deleted lines) and then at the first cached copy
+               of the same text.
+
+  Dependencies:
+    - parser.h
+    - <string>, <vector>, <memory>, <cstdint>, <cstddef>
+  -----------------------------------------------------------------------------*/
+#ifndef ASSEMBLY_CACHE_H
+#define ASSEMBLY_CACHE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "parser.h"
+
+class MappedSource;
+
+// Current cache layout; files of any other version are ignored
+const uint32_t ASSEMBLY_CACHE_VERSION = 1;
+
+class AssemblyCache {
+public:
+    AssemblyCache();
+    ~AssemblyCache();
+
+    AssemblyCache(const AssemblyCache&) = delete;
+    AssemblyCache& operator=(const AssemblyCache&) = delete;
+
+    /**
+     * Reads a cache written by save(). A missing, stale or corrupt file
+     * leaves the cache empty, so every instruction is encoded.
+     *
+     * @param path - Cache file path
+     * @return true if the cache was loaded
+     */
+    bool load(const std::string& path);
+
+    /**
+     * Writes the hashes and words of this run and its label table.
+     *
+     * @param path   - Cache file path
+     * @param hashes - hashInstruction of every instruction, in order
+     * @param words  - Encoded words, one per hash
+     * @param labels - Every label in the program
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void save(const std::string& path, const std::vector<uint64_t>& hashes,
+                     const std::vector<uint32_t>& words, const LabelTable& labels);
+
+    /**
+     * Encodes tokens like assembleWords, reusing cached words wherever the
+     * instruction and its branch or jump target are unchanged. Words and
+     * hashes are appended, so the chunks of a -j parse can be fed in order.
+     *
+     * @param tokens - Tokens from parseSource
+     * @param basePc - Address of the first token
+     * @param labels - Every label in the program
+     * @param words  - Receives one encoded word per token
+     * @param hashes - Receives hashInstruction of each token, for save()
+     * @return Number of words taken from the cache
+     * @throws std::runtime_error on malformed or unsupported instructions
+     */
+    size_t assemble(const std::vector<TokenView>& tokens, uint32_t basePc, const LabelTable& labels,
+                    std::vector<uint32_t>& words, std::vector<uint64_t>& hashes);
+
+    // Number of instructions in the loaded cache
+    size_t size() const { return count; }
+
+private:
+    // Cached index to reuse for token at pc, or -1
+    long findReusable(const TokenView& token, uint64_t hash, uint32_t pc, const LabelTable& labels);
+    // True when the cached word at index is still correct at pc
+    bool targetUnchanged(const TokenView& token, size_t index, uint32_t pc,
+                         const LabelTable& labels) const;
+    // Fills byHash from the cached hashes
+    void buildIndex();
+
+    // Mapped cache file; the arrays and label names point into it
+    std::unique_ptr<MappedSource> file;
+    const uint64_t* cachedHashes;
+    const uint32_t* cachedWords;
+    size_t count;
+    LabelTable cachedLabels;
+    // Cached indices by hash, built on first use, for lines that moved
+    std::vector<uint32_t> byHash;
+    // Cached index minus new index of the last reused line
+    long shift;
+};
+
+/**
+ * 64-bit hash of an instruction's operation and operands.
+ *
+ * @param token - Token from parseSource
+ * @return Hash that ignores spacing, comments and labels
+ */
+uint64_t hashInstruction(const TokenView& token);
+
+#endif // ASSEMBLY_CACHE_H
@@ -0,0 +1,128 @@
+/*------------------------------------------------------------------------------
+  File:        batch_assembler.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements batch mode: input expansion, the pooled run and the
+               aggregate summary.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - batch_assembler.h, work_pool.h
+    - <fstream>, <iostream>, <unordered_set>, <chrono>, <stdexcept>
+    - POSIX glob (<glob.h>)
+  -----------------------------------------------------------------------------*/
+#include "batch_assembler.h"
+#include "work_pool.h"
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+#include <chrono>
+#include <stdexcept>
+
+#include <glob.h>
+
+using namespace std;
+
+// Appends the files matching pattern in glob's sorted order
+static void expandPattern(const string& pattern, vector<string>& paths) {
+    glob_t matches;
+    int status = glob(pattern.c_str(), 0, nullptr, &matches);
+    if (status == 0) {
+        for (size_t i = 0; i < matches.gl_pathc; ++i)
+            paths.push_back(matches.gl_pathv[i]);
+    }
+    globfree(&matches);
+    if (status != 0)
+        throw runtime_error("No files match " + pattern);
+}
+
+static void expandArgument(const string& argument, vector<string>& paths) {
+    if (argument.find_first_of("*?[") != string::npos)
+        expandPattern(argument, paths);
+    else
+        paths.push_back(argument);
+}
+
+vector<string> expandBatchInputs(const vector<string>& arguments) {
+    vector<string> paths;
+    for (const string& argument : arguments) {
+        if (argument.empty() || argument[0] != '@') {
+            expandArgument(argument, paths);
+            continue;
+        }
+        string manifestPath = argument.substr(1);
+        ifstream manifest(manifestPath);
+        if (!manifest) {
+            throw runtime_error("Cannot open manifest: " + manifestPath);
+        }
+        string line;
+        while (getline(manifest, line)) {
+            size_t start = line.find_first_not_of(" \t\r");
+            if (start == string::npos || line[start] == '#')
+                continue;
+            size_t end = line.find_last_not_of(" \t\r");
+            expandArgument(line.substr(start, end - start + 1), paths);
+        }
+    }
+
+    // Two pool threads must never write the same output
+    vector<string> unique;
+    unordered_set<string> seen;
+    for (string& path : paths) {
+        if (seen.insert(path).second)
+            unique.push_back(move(path));
+    }
+    return unique;
+}
+
+string batchOutputPath(const string& inputPath, OutputFormat format) {
+    const char* extension = (format == OutputFormat::Binary) ? ".obj" : ".txt";
+    size_t slash = inputPath.find_last_of('/');
+    size_t dot = inputPath.find_last_of('.');
+    // Only a dot in the file name starts an extension
+    bool hasExtension = dot != string::npos && (slash == string::npos || dot > slash + 1);
+    string outputPath = (hasExtension ? inputPath.substr(0, dot) : inputPath) + extension;
+    if (outputPath == inputPath)
+        outputPath = inputPath + extension;
+    return outputPath;
+}
+
+int runBatchAssembler(const vector<string>& arguments, const AssemblerOptions& options) {
+    auto start = chrono::steady_clock::now();
+    vector<string> inputs;
+    try {
+        inputs = expandBatchInputs(arguments);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    // The pool provides the parallelism; each file runs on one thread
+    AssemblerOptions fileOptions = options;
+    fileOptions.threads = 1;
+    vector<AssemblyResult> results(inputs.size());
+    runWorkStealing(inputs.size(), options.threads, [&](size_t i) {
+        results[i] = assembleFile(inputs[i], batchOutputPath(inputs[i], options.format), fileOptions);
+    });
+    double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    size_t assembled = 0;
+    size_t instructions = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (results[i].ok) {
+            ++assembled;
+            instructions += results[i].instructions;
+        } else {
+            cerr << "Error: " << inputs[i] << ": " << results[i].error << endl;
+        }
+    }
+    size_t failed = inputs.size() - assembled;
+    cout << "Batch: assembled " << assembled << " of " << inputs.size() << " file(s), "
+         << failed << " failed, " << instructions << " instruction(s) in " << elapsed
+         << " ms on " << min<size_t>(options.threads, max<size_t>(inputs.size(), 1))
+         << " thread(s)" << endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+/*------------------------------------------------------------------------------
+  File:        batch_assembler.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares batch mode, which assembles many source files in one
+               invocation on a work-stealing thread pool.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Inputs come from the command line, from manifest files
+               ("@list.txt", one path or pattern per line) or from glob
+               patterns. Each file is assembled by assembleFile on one pool
+               thread and written next to its input. A file that fails is
+               reported and counted; the rest of the batch carries on.
+
+  Dependencies:
+    - tiny_mips_asm.h
+    - <string>, <vector>
+  -----------------------------------------------------------------------------*/
+#ifndef BATCH_ASSEMBLER_H
+#define BATCH_ASSEMBLER_H
+
+#include <string>
+#include <vector>
+#include "tiny_mips_asm.h"
+
+/**
+ * Turns batch arguments into input paths, in order and without duplicates.
+ * "@file" reads a manifest (blank lines and '#' comments are skipped), an
+ * argument containing '*', '?' or '[' is expanded with glob(3), and anything
+ * else is taken as a path.
+ *
+ * @param arguments - Paths, patterns and @manifests from the command line
+ * @return Input file paths
+ * @throws std::runtime_error if a manifest cannot be read or a pattern
+ *         matches nothing
+ */
+std::vector<std::string> expandBatchInputs(const std::vector<std::string>& arguments);
+
+/**
+ * Output path beside an input: its extension replaced by .txt or .obj. If
+ * that would be the input itself, the extension is appended instead.
+ *
+ * @param inputPath - Source file path
+ * @param format    - Output format of the batch
+ * @return Path the output is written to
+ */
+std::string batchOutputPath(const std::string& inputPath, OutputFormat format);
+
+/**
+ * Assembles every input on options.threads pool threads (each file on a
+ * single thread), then prints the failures in input order and a summary.
+ *
+ * @param arguments - Paths, patterns and @manifests from the command line
+ * @param options   - Settings applied to every file
+ * @return 0 if every file was assembled, 1 otherwise
+ */
+int runBatchAssembler(const std::vector<std::string>& arguments, const AssemblerOptions& options);
+
+#endif // BATCH_ASSEMBLER_H
@@ -0,0 +1,250 @@
+/*------------------------------------------------------------------------------
+  File:        bitstring_codec.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements the SSE2/AVX2 bitstring formatter and parser with
+               their scalar fallback.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - bitstring_codec.h
+    - <stdexcept>, <immintrin.h> on x86
+  -----------------------------------------------------------------------------*/
+#include "bitstring_codec.h"
+#include <stdexcept>
+
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(TINY_MIPS_NO_SIMD)
+#define TINY_MIPS_SIMD_CODEC 1
+#include <immintrin.h>
+#ifndef TINY_MIPS_NO_AVX2
+#define TINY_MIPS_AVX2_CODEC 1
+#endif
+#endif
+
+using namespace std;
+
+// Bit loops used for irregular lines and on hosts without SSE2
+static inline void encodeScalar(uint32_t word, char* line) {
+    for (int bit = 0; bit < 32; ++bit)
+        line[bit] = ((word >> (31 - bit)) & 1) ? '1' : '0';
+    line[32] = '\n';
+}
+
+static inline bool decodeScalar(const char* line, uint32_t& word) {
+    uint32_t value = 0;
+    for (int i = 0; i < 32; ++i) {
+        // Wraps for anything below '0', so one compare rejects every other byte
+        uint32_t bit = static_cast<uint8_t>(line[i]) - static_cast<uint32_t>('0');
+        if (bit > 1)
+            return false;
+        value = (value << 1) | bit;
+    }
+    word = value;
+    return true;
+}
+
+// Each parseRun decodes the regular lines (32 bits and '\n') at the front of
+// data and stops at the first line that is anything else
+
+#ifdef TINY_MIPS_SIMD_CODEC
+// Byte i of each 8-byte group selects bit 7 - i, so the most significant
+// bit of a source byte lands on the first character
+static const long long BIT_SELECT = 0x0102040810204080LL;
+
+static inline void encodeSse2(uint32_t word, char* line) {
+    const __m128i bits = _mm_set1_epi64x(BIT_SELECT);
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    // Spread the bytes, most significant first, eight copies each
+    __m128i spread = _mm_cvtsi32_si128(static_cast<int>(__builtin_bswap32(word)));
+    spread = _mm_unpacklo_epi8(spread, spread);
+    spread = _mm_unpacklo_epi16(spread, spread);
+    __m128i high = _mm_unpacklo_epi32(spread, spread);
+    __m128i low = _mm_unpackhi_epi32(spread, spread);
+    // A set bit compares to all ones (-1), so '0' - mask gives '1'
+    high = _mm_sub_epi8(zeroChar, _mm_cmpeq_epi8(_mm_and_si128(high, bits), bits));
+    low = _mm_sub_epi8(zeroChar, _mm_cmpeq_epi8(_mm_and_si128(low, bits), bits));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(line), high);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(line + 16), low);
+    line[32] = '\n';
+}
+
+// Reverses the 16 bytes so movemask puts the first character in the top bit
+static inline __m128i reverseBytes(__m128i v) {
+    v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+static inline bool decodeSse2(const char* line, uint32_t& word) {
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    const __m128i oneChar = _mm_set1_epi8('1');
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line));
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + 16));
+    __m128i highOnes = _mm_cmpeq_epi8(high, oneChar);
+    __m128i lowOnes = _mm_cmpeq_epi8(low, oneChar);
+    __m128i valid = _mm_and_si128(_mm_or_si128(highOnes, _mm_cmpeq_epi8(high, zeroChar)),
+                                  _mm_or_si128(lowOnes, _mm_cmpeq_epi8(low, zeroChar)));
+    if (_mm_movemask_epi8(valid) != 0xFFFF)
+        return false;
+    word = (static_cast<uint32_t>(_mm_movemask_epi8(reverseBytes(highOnes))) << 16) |
+           static_cast<uint32_t>(_mm_movemask_epi8(reverseBytes(lowOnes)));
+    return true;
+}
+
+static void formatSse2(const uint32_t* words, size_t count, char* out) {
+    for (size_t i = 0; i < count; ++i)
+        encodeSse2(words[i], out + i * BITSTRING_LINE_BYTES);
+}
+
+static size_t parseRunSse2(const char* data, size_t size, uint32_t* words) {
+    size_t count = 0;
+    for (; (count + 1) * BITSTRING_LINE_BYTES <= size; ++count) {
+        const char* line = data + count * BITSTRING_LINE_BYTES;
+        if (line[32] != '\n' || !decodeSse2(line, words[count]))
+            break;
+    }
+    return count;
+}
+
+#ifdef TINY_MIPS_AVX2_CODEC
+// Compiled for AVX2 only; called after the run-time CPU check
+__attribute__((target("avx2")))
+static inline void encodeAvx2(uint32_t word, char* line) {
+    // In-lane shuffle: bytes 3 and 2 fill the low lane, 1 and 0 the high lane
+    const __m256i spreadIndex = _mm256_setr_epi8(
+        3, 3, 3, 3, 3, 3, 3, 3, 2, 2, 2, 2, 2, 2, 2, 2,
+        1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i bits = _mm256_set1_epi64x(BIT_SELECT);
+    __m256i spread = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(word)), spreadIndex);
+    __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(spread, bits), bits);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(line), _mm256_sub_epi8(_mm256_set1_epi8('0'), set));
+    line[32] = '\n';
+}
+
+__attribute__((target("avx2")))
+static inline bool decodeAvx2(const char* line, uint32_t& word) {
+    const __m256i reverseIndex = _mm256_setr_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i text = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(line));
+    __m256i ones = _mm256_cmpeq_epi8(text, _mm256_set1_epi8('1'));
+    __m256i valid = _mm256_or_si256(ones, _mm256_cmpeq_epi8(text, _mm256_set1_epi8('0')));
+    if (static_cast<uint32_t>(_mm256_movemask_epi8(valid)) != 0xFFFFFFFFu)
+        return false;
+    // Reverse each lane, then swap the lanes
+    __m256i reversed = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(ones, reverseIndex),
+                                                _MM_SHUFFLE(1, 0, 3, 2));
+    word = static_cast<uint32_t>(_mm256_movemask_epi8(reversed));
+    return true;
+}
+
+__attribute__((target("avx2")))
+static void formatAvx2(const uint32_t* words, size_t count, char* out) {
+    for (size_t i = 0; i < count; ++i)
+        encodeAvx2(words[i], out + i * BITSTRING_LINE_BYTES);
+}
+
+__attribute__((target("avx2")))
+static size_t parseRunAvx2(const char* data, size_t size, uint32_t* words) {
+    size_t count = 0;
+    for (; (count + 1) * BITSTRING_LINE_BYTES <= size; ++count) {
+        const char* line = data + count * BITSTRING_LINE_BYTES;
+        if (line[32] != '\n' || !decodeAvx2(line, words[count]))
+            break;
+    }
+    return count;
+}
+#endif
+#else
+static void formatScalar(const uint32_t* words, size_t count, char* out) {
+    for (size_t i = 0; i < count; ++i)
+        encodeScalar(words[i], out + i * BITSTRING_LINE_BYTES);
+}
+
+static size_t parseRunScalar(const char* data, size_t size, uint32_t* words) {
+    size_t count = 0;
+    for (; (count + 1) * BITSTRING_LINE_BYTES <= size; ++count) {
+        const char* line = data + count * BITSTRING_LINE_BYTES;
+        if (line[32] != '\n' || !decodeScalar(line, words[count]))
+            break;
+    }
+    return count;
+}
+#endif
+
+struct CodecChoice {
+    void (*format)(const uint32_t*, size_t, char*);
+    size_t (*parseRun)(const char*, size_t, uint32_t*);
+    const char* name;
+};
+
+// Picked once per process; static initialization is thread-safe
+static const CodecChoice& codec() {
+    static const CodecChoice choice = [] {
+#ifdef TINY_MIPS_SIMD_CODEC
+#ifdef TINY_MIPS_AVX2_CODEC
+        if (__builtin_cpu_supports("avx2"))
+            return CodecChoice{formatAvx2, parseRunAvx2, "avx2"};
+#endif
+        return CodecChoice{formatSse2, parseRunSse2, "sse2"};
+#else
+        return CodecChoice{formatScalar, parseRunScalar, "scalar"};
+#endif
+    }();
+    return choice;
+}
+
+void formatBitstrings(const uint32_t* words, size_t count, char* out) {
+    codec().format(words, count, out);
+}
+
+string formatBitstrings(const vector<uint32_t>& words) {
+    string text(words.size() * BITSTRING_LINE_BYTES, '\0');
+    formatBitstrings(words.data(), words.size(), &text[0]);
+    return text;
+}
+
+vector<uint32_t> parseBitstrings(string_view text, const string& name) {
+    const CodecChoice& chosen = codec();
+    // Every word takes a full line, so this bounds the count without a
+    // first pass; the unterminated last line is the + 1
+    vector<uint32_t> words(text.size() / BITSTRING_LINE_BYTES + 1);
+    size_t count = 0;
+    size_t pos = 0;
+    size_t lineNumber = 1;
+    while (pos < text.size()) {
+        size_t run = chosen.parseRun(text.data() + pos, text.size() - pos, words.data() + count);
+        count += run;
+        pos += run * BITSTRING_LINE_BYTES;
+        lineNumber += run;
+        if (pos >= text.size())
+            break;
+
+        // Anything the run stopped at: CRLF, blank, comment, a last line
+        // without '\n', or a malformed line
+        size_t end = text.find('\n', pos);
+        if (end == string_view::npos)
+            end = text.size();
+        string_view line = text.substr(pos, end - pos);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.size() == 32 && decodeScalar(line.data(), words[count])) {
+            ++count;
+        } else if (!line.empty() && line[0] != '#') {
+            throw runtime_error("Malformed program " + name + " at line " + to_string(lineNumber) +
+                                ": expected 32 '0'/'1' characters");
+        }
+        pos = end + 1;
+        ++lineNumber;
+    }
+    words.resize(count);
+    return words;
+}
+
+const char* bitstringCodecName() {
+    return codec().name;
+}
@@ -0,0 +1,74 @@
+/*------------------------------------------------------------------------------
+  File:        bitstring_codec.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the bulk converter between machine words and the
+               one-bitstring-per-line text format.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               The text format stores each word as 32 '0'/'1' characters,
+               most significant bit first, followed by '\n'. Both directions
+               work on whole arrays: formatting writes straight into a buffer
+               the caller sized for the whole program, and parsing decodes
+               every line of a file that is already in memory.
+
+               A word is expanded to 32 characters, or 32 characters are
+               checked and packed back into a word, with byte-wise compares
+               and movemask in blocks of 16 (SSE2) or 32 (AVX2). As with the
+               source scanner, AVX2 is chosen at run time when the CPU has
+               it, SSE2 on any other x86-64 host, and a bit loop everywhere
+               else. Define TINY_MIPS_NO_AVX2 to stop at SSE2, or
+               TINY_MIPS_NO_SIMD to force the bit loop.
+
+  Dependencies:
+    - <string>, <string_view>, <vector>, <cstddef>, <cstdint>
+  -----------------------------------------------------------------------------*/
+#ifndef BITSTRING_CODEC_H
+#define BITSTRING_CODEC_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Every text line is the 32 bits plus '\n'
+const size_t BITSTRING_LINE_BYTES = 33;
+
+/**
+ * Writes words as text lines, one after another.
+ *
+ * @param words - First word to write
+ * @param count - Number of words
+ * @param out   - Receives count * BITSTRING_LINE_BYTES bytes
+ */
+void formatBitstrings(const uint32_t* words, size_t count, char* out);
+
+/**
+ * @param words - Words to write
+ * @return The whole text file for words
+ */
+std::string formatBitstrings(const std::vector<uint32_t>& words);
+
+/**
+ * Decodes a text program. Each line must be exactly 32 '0'/'1' characters;
+ * a trailing '\r', blank lines and lines starting with '#' are accepted, and
+ * the last line may omit its newline.
+ *
+ * @param text - File contents
+ * @param name - File name used in error messages
+ * @return Words in file order
+ * @throws std::runtime_error naming the first malformed line
+ */
+std::vector<uint32_t> parseBitstrings(std::string_view text, const std::string& name);
+
+/**
+ * @return Name of the codec selected for this CPU: "avx2", "sse2" or "scalar"
+ */
+const char* bitstringCodecName();
+
+#endif // BITSTRING_CODEC_H
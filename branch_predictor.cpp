@@ -0,0 +1,199 @@
+/*------------------------------------------------------------------------------
+  File:        branch_predictor.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements the beq direction predictors, the BTB for j and
+               the accuracy report.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - branch_predictor.h, disassembler.h
+    - <algorithm>, <iomanip>, <stdexcept>, <cstdlib>
+  -----------------------------------------------------------------------------*/
+#include "branch_predictor.h"
+#include "disassembler.h"
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#include <cstdlib>
+
+using namespace std;
+
+static const uint32_t OPCODE_J = 0x02;
+static const uint32_t OPCODE_BEQ = 0x04;
+static const uint32_t NO_ENTRY = 0xFFFFFFFF;
+
+static const char* predictorName(PredictorKind kind) {
+    switch (kind) {
+        case PredictorKind::NotTaken: return "static not-taken";
+        case PredictorKind::OneBit:   return "1-bit";
+        case PredictorKind::TwoBit:   return "2-bit";
+        case PredictorKind::Gshare:   return "gshare";
+    }
+    return "";
+}
+
+bool parsePredictorKind(const string& text, PredictorConfig& config) {
+    if (text == "not-taken") {
+        config.kind = PredictorKind::NotTaken;
+    } else if (text == "1bit") {
+        config.kind = PredictorKind::OneBit;
+    } else if (text == "2bit") {
+        config.kind = PredictorKind::TwoBit;
+    } else if (text.rfind("gshare", 0) == 0) {
+        if (text.size() > 6) {
+            if (text[6] != ':')
+                return false;
+            char* end;
+            unsigned long bits = strtoul(text.c_str() + 7, &end, 10);
+            if (*end != '\0' || end == text.c_str() + 7 || bits == 0 || bits > 24)
+                return false;
+            config.historyBits = static_cast<unsigned>(bits);
+        }
+        config.kind = PredictorKind::Gshare;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+BranchPredictor::BranchPredictor(const PredictorConfig& config)
+    : settings(config), history(0) {
+    if (config.tableBits > 24 || config.historyBits > 24) {
+        throw invalid_argument("Predictor tables are limited to 2^24 entries");
+    }
+    if (config.btbEntries & (config.btbEntries - 1)) {
+        throw invalid_argument("BTB size must be a power of two");
+    }
+    // 2-bit counters start weakly not taken, 1-bit entries not taken
+    uint8_t initial = (config.kind == PredictorKind::OneBit) ? 0 : 1;
+    table.assign(size_t(1) << config.tableBits, initial);
+    tableMask = (1u << config.tableBits) - 1;
+    historyMask = (1u << config.historyBits) - 1;
+    btbPc.assign(config.btbEntries, NO_ENTRY);
+    btbTarget.assign(config.btbEntries, 0);
+}
+
+bool BranchPredictor::predictTaken(uint32_t index) const {
+    switch (settings.kind) {
+        case PredictorKind::NotTaken: return false;
+        case PredictorKind::OneBit:   return table[index] != 0;
+        case PredictorKind::TwoBit:
+        case PredictorKind::Gshare:   return table[index] >= 2;
+    }
+    return false;
+}
+
+void BranchPredictor::train(uint32_t index, bool taken) {
+    uint8_t& entry = table[index];
+    switch (settings.kind) {
+        case PredictorKind::NotTaken:
+            break;
+        case PredictorKind::OneBit:
+            entry = taken ? 1 : 0;
+            break;
+        case PredictorKind::TwoBit:
+        case PredictorKind::Gshare:
+            if (taken && entry < 3)
+                ++entry;
+            else if (!taken && entry > 0)
+                --entry;
+            break;
+    }
+    if (settings.kind == PredictorKind::Gshare)
+        history = ((history << 1) | (taken ? 1 : 0)) & historyMask;
+}
+
+PredictionOutcome BranchPredictor::resolve(const RetireRecord& record) {
+    uint32_t opcode = record.instruction >> 26;
+    bool correct;
+    if (opcode == OPCODE_BEQ) {
+        bool taken = (record.flags & RETIRE_BRANCH_TAKEN) != 0;
+        uint32_t index = (record.pc >> 2) & tableMask;
+        if (settings.kind == PredictorKind::Gshare)
+            index = ((record.pc >> 2) ^ history) & tableMask;
+        correct = predictTaken(index) == taken;
+        train(index, taken);
+
+        ++counters.branches;
+        counters.branchesCorrect += correct;
+        BranchSiteStats& site = sites[record.pc];
+        site.instruction = record.instruction;
+        ++site.executed;
+        site.taken += taken;
+        site.correct += correct;
+    } else if (opcode == OPCODE_J) {
+        uint32_t target = (record.pc & 0xF0000000) | ((record.instruction & 0x03FFFFFF) << 2);
+        correct = false;
+        if (!btbPc.empty()) {
+            size_t slot = (record.pc >> 2) & (btbPc.size() - 1);
+            correct = btbPc[slot] == record.pc && btbTarget[slot] == target;
+            btbPc[slot] = record.pc;
+            btbTarget[slot] = target;
+        }
+
+        ++counters.jumps;
+        counters.jumpsCorrect += correct;
+        BranchSiteStats& site = sites[record.pc];
+        site.instruction = record.instruction;
+        ++site.executed;
+        ++site.taken;
+        site.correct += correct;
+    } else {
+        return PredictionOutcome::NotControl;
+    }
+    return correct ? PredictionOutcome::Correct : PredictionOutcome::Mispredicted;
+}
+
+void BranchPredictor::report(ostream& out, size_t maxSites) const {
+    const PredictorStats& s = counters;
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    auto percent = [](uint64_t part, uint64_t whole) {
+        return whole ? 100.0 * double(part) / double(whole) : 0.0;
+    };
+
+    out << "Branch predictor: " << predictorName(settings.kind);
+    if (settings.kind == PredictorKind::Gshare)
+        out << " (" << settings.historyBits << "-bit history)";
+    if (settings.kind != PredictorKind::NotTaken)
+        out << ", " << (1u << settings.tableBits) << " entries";
+    if (settings.btbEntries)
+        out << ", " << settings.btbEntries << "-entry BTB\n";
+    else
+        out << ", no BTB\n";
+    out << fixed << setprecision(2);
+    out << "  beq: " << s.branchesCorrect << " of " << s.branches << " predicted ("
+        << percent(s.branchesCorrect, s.branches) << "%)\n";
+    out << "  j: " << s.jumpsCorrect << " of " << s.jumps << " BTB hits ("
+        << percent(s.jumpsCorrect, s.jumps) << "%)\n";
+    uint64_t correct = s.branchesCorrect + s.jumpsCorrect;
+    uint64_t total = s.branches + s.jumps;
+    out << "  Overall: " << correct << " of " << total << " (" << percent(correct, total) << "%)\n";
+
+    // Sites with the most mispredictions first, then the kept ones by pc
+    vector<pair<uint32_t, BranchSiteStats>> ordered(sites.begin(), sites.end());
+    sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+        uint64_t missA = a.second.executed - a.second.correct;
+        uint64_t missB = b.second.executed - b.second.correct;
+        return missA != missB ? missA > missB : a.first < b.first;
+    });
+    if (ordered.size() > maxSites) {
+        out << "  Showing " << maxSites << " of " << ordered.size()
+            << " sites with the most mispredictions\n";
+        ordered.resize(maxSites);
+    }
+    sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& entry : ordered) {
+        const BranchSiteStats& site = entry.second;
+        out << "  [" << hex << setw(8) << setfill('0') << entry.first << dec << setfill(' ') << "] "
+            << left << setw(20) << disassembleInstruction(site.instruction, entry.first) << right
+            << site.correct << " of " << site.executed << " predicted ("
+            << percent(site.correct, site.executed) << "%), taken " << site.taken << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,122 @@
+/*------------------------------------------------------------------------------
+  File:        branch_predictor.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the branch prediction model for beq and j.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               beq directions come from one of four predictors:
+
+               - NotTaken: always not taken (what the plain pipeline assumes)
+               - OneBit:   last outcome, per pc
+               - TwoBit:   2-bit saturating counter per pc, starting weakly
+                           not taken
+               - Gshare:   2-bit counters indexed by pc XOR a global history
+                           of the last historyBits outcomes
+
+               Per-pc tables have 2^tableBits entries and aliasing is
+               allowed, as in hardware. j targets come from a direct-mapped
+               branch target buffer: a j is predicted only if its pc hits in
+               the BTB with the right target. beq targets are pc-relative
+               and known in ID, so only their direction is predicted.
+
+               Every prediction is checked against the actual outcome and
+               the tables are then updated. Accuracy is kept overall and
+               per branch pc.
+
+  Dependencies:
+    - retire_trace.h
+    - <cstdint>, <string>, <vector>, <unordered_map>, <ostream>
+  -----------------------------------------------------------------------------*/
+#ifndef BRANCH_PREDICTOR_H
+#define BRANCH_PREDICTOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <ostream>
+#include "retire_trace.h"
+
+enum class PredictorKind { NotTaken, OneBit, TwoBit, Gshare };
+
+struct PredictorConfig {
+    PredictorKind kind = PredictorKind::TwoBit;
+    // log2 of the counter table size
+    unsigned tableBits = 10;
+    // Global history length for gshare
+    unsigned historyBits = 8;
+    // Direct-mapped BTB entries for j (power of two, 0 for no BTB)
+    unsigned btbEntries = 64;
+};
+
+/**
+ * Parses "not-taken", "1bit", "2bit" or "gshare[:HISTORY]".
+ *
+ * @param text   - Predictor name from the command line
+ * @param config - kind (and historyBits) updated on success
+ * @return true if the name was recognized
+ */
+bool parsePredictorKind(const std::string& text, PredictorConfig& config);
+
+// What a predictor made of one retired instruction
+enum class PredictionOutcome { NotControl, Correct, Mispredicted };
+
+struct BranchSiteStats {
+    uint32_t instruction = 0;
+    uint64_t executed = 0;
+    uint64_t taken = 0;
+    uint64_t correct = 0;
+};
+
+struct PredictorStats {
+    uint64_t branches = 0;
+    uint64_t branchesCorrect = 0;
+    uint64_t jumps = 0;
+    uint64_t jumpsCorrect = 0;
+};
+
+class BranchPredictor {
+public:
+    // Throws std::invalid_argument for tables over 2^24 entries or a BTB
+    // size that is not a power of two
+    explicit BranchPredictor(const PredictorConfig& config);
+
+    /**
+     * Predicts a retired beq or j, compares with what it actually did and
+     * trains the predictor.
+     *
+     * @param record - Retired instruction
+     * @return NotControl for any other instruction
+     */
+    PredictionOutcome resolve(const RetireRecord& record);
+
+    const PredictorConfig& config() const { return settings; }
+    const PredictorStats& stats() const { return counters; }
+
+    // Prints overall accuracy and the per-pc breakdown (at most maxSites
+    // sites, those with the most mispredictions)
+    void report(std::ostream& out, size_t maxSites = 32) const;
+
+private:
+    bool predictTaken(uint32_t index) const;
+    void train(uint32_t index, bool taken);
+
+    PredictorConfig settings;
+    PredictorStats counters;
+    // 1-bit outcomes or 2-bit counters, one byte each
+    std::vector<uint8_t> table;
+    uint32_t tableMask;
+    uint32_t history;
+    uint32_t historyMask;
+    // BTB: tagged by the full pc, UINT32_MAX when empty
+    std::vector<uint32_t> btbPc;
+    std::vector<uint32_t> btbTarget;
+    std::unordered_map<uint32_t, BranchSiteStats> sites;
+};
+
+#endif // BRANCH_PREDICTOR_H
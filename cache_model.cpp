@@ -0,0 +1,197 @@
+/*------------------------------------------------------------------------------
+  File:        cache_model.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements the set-associative cache model and its command
+               line description.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - cache_model.h
+    - <sstream>, <iomanip>, <stdexcept>, <cstdlib>
+  -----------------------------------------------------------------------------*/
+#include "cache_model.h"
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <cstdlib>
+
+using namespace std;
+
+static bool isPowerOfTwo(uint32_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+static uint32_t log2Of(uint32_t value) {
+    uint32_t bits = 0;
+    while ((1u << bits) < value)
+        ++bits;
+    return bits;
+}
+
+static bool validGeometry(const CacheConfig& config) {
+    return isPowerOfTwo(config.sizeBytes) && isPowerOfTwo(config.lineBytes)
+        && isPowerOfTwo(config.associativity) && config.lineBytes >= 4
+        && uint64_t(config.lineBytes) * config.associativity <= config.sizeBytes;
+}
+
+// Byte count with an optional K suffix
+static bool parseBytes(const string& field, uint32_t& value) {
+    if (field.empty())
+        return false;
+    char* end;
+    unsigned long number = strtoul(field.c_str(), &end, 10);
+    if (*end == 'K' || *end == 'k') {
+        number *= 1024;
+        ++end;
+    }
+    if (*end != '\0' || end == field.c_str() || number > 0x80000000ul)
+        return false;
+    value = static_cast<uint32_t>(number);
+    return true;
+}
+
+bool parseCacheConfig(const string& text, CacheConfig& config) {
+    vector<string> fields;
+    stringstream in(text);
+    string field;
+    while (getline(in, field, ':'))
+        fields.push_back(field);
+    if (fields.size() < 3 || fields.size() > 5)
+        return false;
+
+    CacheConfig parsed = config;
+    if (!parseBytes(fields[0], parsed.sizeBytes) || !parseBytes(fields[1], parsed.lineBytes)
+            || !parseBytes(fields[2], parsed.associativity))
+        return false;
+    for (size_t i = 3; i < fields.size(); ++i) {
+        if (fields[i] == "lru")
+            parsed.replacement = ReplacementPolicy::Lru;
+        else if (fields[i] == "fifo")
+            parsed.replacement = ReplacementPolicy::Fifo;
+        else if (fields[i] == "random")
+            parsed.replacement = ReplacementPolicy::Random;
+        else if (fields[i] == "wb")
+            parsed.writePolicy = WritePolicy::WriteBack;
+        else if (fields[i] == "wt")
+            parsed.writePolicy = WritePolicy::WriteThrough;
+        else
+            return false;
+    }
+    if (!validGeometry(parsed))
+        return false;
+    config = parsed;
+    return true;
+}
+
+CacheModel::CacheModel(const CacheConfig& config)
+    : settings(config), clock(0), randomState(0x9E3779B9u) {
+    if (!validGeometry(config)) {
+        throw invalid_argument("Cache size, line size and associativity must be powers of two "
+                               "with at least one line per way");
+    }
+    uint32_t lines = config.sizeBytes / config.lineBytes;
+    uint32_t sets = lines / config.associativity;
+    lineShift = log2Of(config.lineBytes);
+    setShift = log2Of(sets);
+    setMask = sets - 1;
+    tags.assign(lines, 0);
+    valid.assign(lines, 0);
+    dirty.assign(lines, 0);
+    stamps.assign(lines, 0);
+}
+
+uint32_t CacheModel::chooseVictim(size_t firstLine) {
+    const uint32_t ways = settings.associativity;
+    if (settings.replacement == ReplacementPolicy::Random) {
+        // xorshift32
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState & (ways - 1);
+    }
+    // LRU and FIFO both replace the oldest stamp; they differ in whether
+    // a hit refreshes it
+    uint32_t victim = 0;
+    for (uint32_t way = 1; way < ways; ++way) {
+        if (stamps[firstLine + way] < stamps[firstLine + victim])
+            victim = way;
+    }
+    return victim;
+}
+
+bool CacheModel::access(uint32_t address, bool write) {
+    ++clock;
+    if (write)
+        ++counters.writes;
+    else
+        ++counters.reads;
+
+    uint32_t lineNumber = address >> lineShift;
+    uint32_t tag = lineNumber >> setShift;
+    size_t firstLine = size_t(lineNumber & setMask) * settings.associativity;
+    bool writeThrough = settings.writePolicy == WritePolicy::WriteThrough;
+    if (write && writeThrough)
+        ++counters.writeThroughs;
+
+    for (uint32_t way = 0; way < settings.associativity; ++way) {
+        size_t line = firstLine + way;
+        if (valid[line] && tags[line] == tag) {
+            ++counters.hits;
+            if (settings.replacement == ReplacementPolicy::Lru)
+                stamps[line] = clock;
+            if (write && !writeThrough)
+                dirty[line] = 1;
+            return true;
+        }
+    }
+
+    ++counters.misses;
+    // Write-through caches do not allocate on a write miss
+    if (write && writeThrough)
+        return false;
+
+    // Prefer an empty way before replacing anything
+    size_t line = firstLine;
+    bool found = false;
+    for (uint32_t way = 0; way < settings.associativity && !found; ++way) {
+        if (!valid[firstLine + way]) {
+            line = firstLine + way;
+            found = true;
+        }
+    }
+    if (!found) {
+        line = firstLine + chooseVictim(firstLine);
+        ++counters.evictions;
+        if (dirty[line])
+            ++counters.writebacks;
+    }
+    tags[line] = tag;
+    valid[line] = 1;
+    dirty[line] = (write && !writeThrough) ? 1 : 0;
+    stamps[line] = clock;
+    return false;
+}
+
+void CacheModel::report(ostream& out, const string& name) const {
+    static const char* const replacementNames[] = {"LRU", "FIFO", "random"};
+    const CacheStats& s = counters;
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+
+    out << name << ": " << settings.sizeBytes << " B, " << settings.lineBytes << " B lines, "
+        << settings.associativity << "-way, " << replacementNames[static_cast<int>(settings.replacement)]
+        << ", " << (settings.writePolicy == WritePolicy::WriteBack ? "write-back" : "write-through") << '\n';
+    out << "  Accesses: " << s.hits + s.misses << " (" << s.reads << " read, " << s.writes << " write)"
+        << ", hits " << s.hits << ", misses " << s.misses
+        << " (" << fixed << setprecision(2) << s.missRate() * 100.0 << "%)\n";
+    out.flags(flags);
+    out.precision(precision);
+    out << "  Evictions: " << s.evictions << ", writebacks: " << s.writebacks;
+    if (settings.writePolicy == WritePolicy::WriteThrough)
+        out << ", write-throughs: " << s.writeThroughs;
+    out << '\n';
+}
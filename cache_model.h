@@ -0,0 +1,117 @@
+/*------------------------------------------------------------------------------
+  File:        cache_model.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the configurable L1 cache model used for the
+               instruction fetch and data (lw/sw) streams.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               A set-associative cache that only tracks tags: the data
+               itself stays in the CPU's memory, so the model never changes
+               what a program computes. Size, line size and associativity
+               must be powers of two.
+
+               Write-back caches allocate on a write miss and count a
+               writeback whenever a dirty line is evicted. Write-through
+               caches do not allocate on a write miss and send every store
+               to memory. Random replacement uses a fixed-seed generator so
+               runs are repeatable.
+
+  Dependencies:
+    - <cstdint>, <string>, <vector>, <ostream>
+  -----------------------------------------------------------------------------*/
+#ifndef CACHE_MODEL_H
+#define CACHE_MODEL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ostream>
+
+enum class ReplacementPolicy { Lru, Fifo, Random };
+
+enum class WritePolicy { WriteBack, WriteThrough };
+
+struct CacheConfig {
+    uint32_t sizeBytes = 4096;
+    uint32_t lineBytes = 32;
+    uint32_t associativity = 2;
+    ReplacementPolicy replacement = ReplacementPolicy::Lru;
+    WritePolicy writePolicy = WritePolicy::WriteBack;
+    // Extra cycles a miss costs the pipeline model
+    unsigned missPenalty = 10;
+};
+
+/**
+ * Parses "SIZE:LINE:WAYS[:lru|fifo|random][:wb|wt]", where SIZE and LINE
+ * are byte counts that may end in K (e.g. "8K:32:4:lru:wb"). Fields left
+ * out keep their value in config.
+ *
+ * @param text   - Cache description from the command line
+ * @param config - Updated on success
+ * @return true if the text is well formed and describes a valid cache
+ */
+bool parseCacheConfig(const std::string& text, CacheConfig& config);
+
+struct CacheStats {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    // Valid lines replaced to make room
+    uint64_t evictions = 0;
+    // Dirty lines written back (write-back only)
+    uint64_t writebacks = 0;
+    // Stores passed on to memory (write-through only)
+    uint64_t writeThroughs = 0;
+
+    double missRate() const {
+        uint64_t accesses = hits + misses;
+        return accesses ? double(misses) / double(accesses) : 0.0;
+    }
+};
+
+class CacheModel {
+public:
+    // Throws std::invalid_argument if the geometry is not valid
+    explicit CacheModel(const CacheConfig& config);
+
+    /**
+     * Looks up the line holding address, filling it on a miss.
+     *
+     * @param address - Byte address accessed
+     * @param write   - true for a store
+     * @return true on a hit
+     */
+    bool access(uint32_t address, bool write);
+
+    const CacheConfig& config() const { return settings; }
+    const CacheStats& stats() const { return counters; }
+
+    // Prints the geometry and counters under the given name
+    void report(std::ostream& out, const std::string& name) const;
+
+private:
+    // Way to refill in a full set
+    uint32_t chooseVictim(size_t firstLine);
+
+    CacheConfig settings;
+    CacheStats counters;
+    uint32_t lineShift;
+    uint32_t setMask;
+    uint32_t setShift;
+    // One entry per line, set-major: tag, valid/dirty bits and the time of
+    // the last use (LRU) or of the fill (FIFO)
+    std::vector<uint32_t> tags;
+    std::vector<uint8_t> valid;
+    std::vector<uint8_t> dirty;
+    std::vector<uint64_t> stamps;
+    uint64_t clock;
+    uint32_t randomState;
+};
+
+#endif // CACHE_MODEL_H
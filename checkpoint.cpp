@@ -0,0 +1,195 @@
+/*------------------------------------------------------------------------------
+  File:        checkpoint.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements TinyMipsCPU::saveCheckpoint and restoreCheckpoint.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - tiny_mips_cpu.h, checkpoint.h
+    - <fstream>, <cstring>, <stdexcept>, <algorithm>, <vector>
+    - POSIX mmap (<sys/mman.h>, <sys/stat.h>, <fcntl.h>, <unistd.h>)
+  -----------------------------------------------------------------------------*/
+#include "tiny_mips_cpu.h"
+#include "checkpoint.h"
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const char CHECKPOINT_MAGIC[4] = {'T', 'M', 'C', 'K'};
+static const uint8_t CHECKPOINT_LITTLE_ENDIAN = 0;
+static const uint8_t CHECKPOINT_BIG_ENDIAN = 1;
+
+// Endianness of the machine running the simulator
+static uint8_t hostEndianness() {
+    const uint16_t probe = 1;
+    uint8_t firstByte;
+    memcpy(&firstByte, &probe, 1);
+    return firstByte == 1 ? CHECKPOINT_LITTLE_ENDIAN : CHECKPOINT_BIG_ENDIAN;
+}
+
+static uint16_t swap16(uint16_t v) {
+    return static_cast<uint16_t>((v >> 8) | (v << 8));
+}
+
+static uint32_t swap32(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0x0000FF00) | ((v << 8) & 0x00FF0000) | (v << 24);
+}
+
+static uint64_t swap64(uint64_t v) {
+    return (uint64_t(swap32(uint32_t(v))) << 32) | swap32(uint32_t(v >> 32));
+}
+
+// Rounds a byte count up to the next page boundary
+static uint64_t alignPage(uint64_t n) {
+    return (n + PagedMemory::PAGE_SIZE - 1) & ~uint64_t(PagedMemory::PAGE_SIZE - 1);
+}
+
+// Read-only mapping of a whole file, unmapped on scope exit
+class MappedCheckpoint {
+public:
+    explicit MappedCheckpoint(const string& path) : data(nullptr), size(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error("Cannot open checkpoint " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(CheckpointHeader)) {
+            close(fd);
+            throw runtime_error("Checkpoint too small: " + path);
+        }
+        size = static_cast<size_t>(info.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            throw runtime_error("Cannot map checkpoint " + path);
+        }
+        data = static_cast<const uint8_t*>(mapping);
+    }
+
+    ~MappedCheckpoint() {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+
+    MappedCheckpoint(const MappedCheckpoint&) = delete;
+    MappedCheckpoint& operator=(const MappedCheckpoint&) = delete;
+
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * Writes the header, the page numbers and every non-zero page in host byte
+ * order, padding so the page contents start on a page boundary.
+ */
+void TinyMipsCPU::saveCheckpoint(const string& path) const {
+    vector<uint32_t> pageNumbers;
+    memory.forEachPage([&pageNumbers](uint32_t pageNumber, const uint8_t* page) {
+        if (any_of(page, page + PagedMemory::PAGE_SIZE, [](uint8_t b) { return b != 0; }))
+            pageNumbers.push_back(pageNumber);
+    });
+
+    CheckpointHeader header{};
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    header.version = CHECKPOINT_VERSION;
+    header.endianness = hostEndianness();
+    header.guestEndianness = memory.endianness() == Endianness::Little ? 1 : 0;
+    header.pc = pc;
+    header.pageCount = static_cast<uint32_t>(pageNumbers.size());
+    header.steps = steps;
+    header.programHash = programHash();
+    header.programWords = instructionMemory.size();
+    copy(registers.begin(), registers.end(), header.registers);
+    header.pageTableOffset = sizeof(CheckpointHeader);
+    header.pageDataOffset = alignPage(header.pageTableOffset + pageNumbers.size() * sizeof(uint32_t));
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) {
+        throw runtime_error("Cannot open checkpoint " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(pageNumbers.data()),
+              static_cast<streamsize>(pageNumbers.size() * sizeof(uint32_t)));
+    uint64_t written = header.pageTableOffset + pageNumbers.size() * sizeof(uint32_t);
+    const char padding[PagedMemory::PAGE_SIZE] = {};
+    out.write(padding, static_cast<streamsize>(header.pageDataOffset - written));
+    for (uint32_t pageNumber : pageNumbers)
+        out.write(reinterpret_cast<const char*>(memory.findPage(pageNumber)), PagedMemory::PAGE_SIZE);
+    if (!out.flush()) {
+        throw runtime_error("Failed to write checkpoint " + path);
+    }
+}
+
+/**
+ * Maps the checkpoint, validates it against the loaded program and then
+ * replaces pc, registers, memory and the step count. Nothing is changed if
+ * the file is rejected.
+ */
+void TinyMipsCPU::restoreCheckpoint(const string& path) {
+    MappedCheckpoint file(path);
+    CheckpointHeader header;
+    memcpy(&header, file.data, sizeof(header));
+    if (memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        throw runtime_error("Not a Tiny MIPS checkpoint: " + path);
+    }
+    bool swapped = header.endianness != hostEndianness();
+    if (swapped) {
+        header.version = swap16(header.version);
+        header.pc = swap32(header.pc);
+        header.pageCount = swap32(header.pageCount);
+        header.steps = swap64(header.steps);
+        header.programHash = swap64(header.programHash);
+        header.programWords = swap64(header.programWords);
+        for (uint32_t& value : header.registers)
+            value = swap32(value);
+        header.pageTableOffset = swap64(header.pageTableOffset);
+        header.pageDataOffset = swap64(header.pageDataOffset);
+    }
+
+    // Offsets come from the file, so the bounds are checked by subtraction;
+    // adding pageCount to a huge offset could wrap past the checks
+    if (header.version != CHECKPOINT_VERSION || header.guestEndianness > 1 || header.pc % 4 != 0
+            || header.pageTableOffset < sizeof(CheckpointHeader) || header.pageTableOffset > header.pageDataOffset
+            || header.pageDataOffset > file.size || header.pageDataOffset % PagedMemory::PAGE_SIZE != 0
+            || header.pageCount > (header.pageDataOffset - header.pageTableOffset) / sizeof(uint32_t)
+            || header.pageCount > (file.size - header.pageDataOffset) / PagedMemory::PAGE_SIZE) {
+        throw runtime_error("Unsupported or corrupt checkpoint: " + path);
+    }
+    if (header.programWords != instructionMemory.size() || header.programHash != programHash()) {
+        throw runtime_error("Checkpoint " + path + " was taken from a different program");
+    }
+
+    const uint8_t* table = file.data + header.pageTableOffset;
+    const uint8_t* pages = file.data + header.pageDataOffset;
+    vector<uint32_t> pageNumbers(header.pageCount);
+    memcpy(pageNumbers.data(), table, pageNumbers.size() * sizeof(uint32_t));
+    for (uint32_t& pageNumber : pageNumbers) {
+        if (swapped)
+            pageNumber = swap32(pageNumber);
+        if (pageNumber >> (32 - PagedMemory::PAGE_BITS)) {
+            throw runtime_error("Unsupported or corrupt checkpoint: " + path);
+        }
+    }
+
+    memory.clear();
+    for (size_t i = 0; i < pageNumbers.size(); ++i) {
+        memory.write(pageNumbers[i] << PagedMemory::PAGE_BITS, pages + i * PagedMemory::PAGE_SIZE,
+                     PagedMemory::PAGE_SIZE);
+    }
+    memory.setEndianness(header.guestEndianness ? Endianness::Little : Endianness::Big);
+    pc = header.pc;
+    copy(begin(header.registers), end(header.registers), registers.begin());
+    steps = header.steps;
+}
@@ -0,0 +1,63 @@
+/*------------------------------------------------------------------------------
+  File:        checkpoint.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the checkpoint file that saves a TinyMipsCPU part way
+               through a run so a later run can resume from it.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Layout of a version 1 checkpoint (all offsets in bytes):
+
+               | 0-183            | CheckpointHeader                     |
+               | pageTableOffset  | page numbers, one 32-bit word each   |
+               | pageDataOffset   | page contents, PAGE_SIZE bytes each, |
+               |                  | in page table order                  |
+
+               Multi-byte header fields and page numbers are in the byte
+               order recorded in the header. Page contents are guest memory
+               bytes and never need swapping. Pages holding only zeros are
+               left out. pageDataOffset is a multiple of the page size, so
+               restoring maps the file and copies whole aligned pages.
+
+               A checkpoint belongs to one program: restoring it into a CPU
+               with other instruction words loaded is refused. Timing models,
+               traces and the step limit are not part of the saved state.
+
+  Dependencies:
+    - <cstdint>
+  -----------------------------------------------------------------------------*/
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+
+// Current checkpoint format version
+const uint16_t CHECKPOINT_VERSION = 1;
+
+// Fixed-size header at the start of every checkpoint
+struct CheckpointHeader {
+    char magic[4];
+    uint16_t version;
+    // Byte order of the header fields and page numbers
+    uint8_t endianness;
+    // Guest byte order of lw/sw (0 big, 1 little)
+    uint8_t guestEndianness;
+    uint32_t pc;
+    uint32_t pageCount;
+    // Instructions retired when the checkpoint was taken
+    uint64_t steps;
+    // TinyMipsCPU::programHash and the word count of the program
+    uint64_t programHash;
+    uint64_t programWords;
+    uint32_t registers[32];
+    uint64_t pageTableOffset;
+    uint64_t pageDataOffset;
+};
+
+static_assert(sizeof(CheckpointHeader) == 184, "CheckpointHeader must stay 184 bytes");
+
+#endif // CHECKPOINT_H
@@ -11,28 +11,85 @@
 
   Dependencies: 
     - converters.h
-    - <stdexcept>, <unordered_map>, <bitset> 
+    - <stdexcept>, <bitset> 
   -----------------------------------------------------------------------------*/
 #include "converters.h"
-#include <unordered_map> 
 #include <stdexcept>
 #include <bitset> 
 
 using namespace std;
 
-// Map of register names to numbers 
-static const unordered_map<string, int> registerMap = {  
-    {"$zero", 0}, {"$at", 1},
-    {"$v0", 2}, {"$v1", 3}, 
-    {"$a0", 4}, {"$a1", 5}, {"$a2", 6}, {"$a3", 7},
-    {"$t0", 8}, {"$t1", 9}, {"$t2", 10}, {"$t3", 11}, 
-    {"$t4", 12}, {"$t5", 13}, {"$t6", 14}, {"$t7", 15},
-    {"$s0", 16}, {"$s1", 17}, {"$s2", 18}, {"$s3", 19},
-    {"$s4", 20}, {"$s5", 21}, {"$s6", 22}, {"$s7", 23},  
-    {"$t8", 24}, {"$t9", 25}, 
-    {"$k0", 26}, {"$k1", 27}, 
-    {"$gp", 28}, {"$sp", 29}, {"$fp", 30}, {"$ra", 31} 
-};
+// Packed-name switch for mnemonics - each case label is a compile-time constant
+Mnemonic lookupMnemonic(string_view op) {
+    switch (packName(op)) {
+        case packName("sll"):  return Mnemonic::Sll;
+        case packName("srl"):  return Mnemonic::Srl;
+        case packName("jr"):   return Mnemonic::Jr;
+        case packName("mult"): return Mnemonic::Mult;
+        case packName("div"):  return Mnemonic::Div;
+        case packName("add"):  return Mnemonic::Add;
+        case packName("sub"):  return Mnemonic::Sub;
+        case packName("and"):  return Mnemonic::And;
+        case packName("or"):   return Mnemonic::Or;
+        case packName("nor"):  return Mnemonic::Nor;
+        case packName("slt"):  return Mnemonic::Slt;
+        case packName("j"):    return Mnemonic::J;
+        case packName("jal"):  return Mnemonic::Jal;
+        case packName("beq"):  return Mnemonic::Beq;
+        case packName("bne"):  return Mnemonic::Bne;
+        case packName("addi"): return Mnemonic::Addi;
+        case packName("slti"): return Mnemonic::Slti;
+        case packName("andi"): return Mnemonic::Andi;
+        case packName("ori"):  return Mnemonic::Ori;
+        case packName("xori"): return Mnemonic::Xori;
+        case packName("lb"):   return Mnemonic::Lb;
+        case packName("lw"):   return Mnemonic::Lw;
+        case packName("sb"):   return Mnemonic::Sb;
+        case packName("sw"):   return Mnemonic::Sw;
+        default:               return Mnemonic::Unknown;
+    }
+}
+
+// Same idea for registers - the '$' is checked and dropped, "zero" still fits
+int lookupRegister(string_view regName) {
+    if (regName.empty() || regName[0] != '$')
+        return -1;
+    switch (packName(regName.substr(1))) {
+        case packName("zero"): return 0;
+        case packName("at"):   return 1;
+        case packName("v0"):   return 2;
+        case packName("v1"):   return 3;
+        case packName("a0"):   return 4;
+        case packName("a1"):   return 5;
+        case packName("a2"):   return 6;
+        case packName("a3"):   return 7;
+        case packName("t0"):   return 8;
+        case packName("t1"):   return 9;
+        case packName("t2"):   return 10;
+        case packName("t3"):   return 11;
+        case packName("t4"):   return 12;
+        case packName("t5"):   return 13;
+        case packName("t6"):   return 14;
+        case packName("t7"):   return 15;
+        case packName("s0"):   return 16;
+        case packName("s1"):   return 17;
+        case packName("s2"):   return 18;
+        case packName("s3"):   return 19;
+        case packName("s4"):   return 20;
+        case packName("s5"):   return 21;
+        case packName("s6"):   return 22;
+        case packName("s7"):   return 23;
+        case packName("t8"):   return 24;
+        case packName("t9"):   return 25;
+        case packName("k0"):   return 26;
+        case packName("k1"):   return 27;
+        case packName("gp"):   return 28;
+        case packName("sp"):   return 29;
+        case packName("fp"):   return 30;
+        case packName("ra"):   return 31;
+        default:               return -1;
+    }
+}
 
 /**
  * Converts a register name like "$t0" to its corresponding register number.
@@ -40,9 +97,9 @@ static const unordered_map<string, int> registerMap = {
  * Throws an error if the register is unrecognized.
  */
 int reg_number(const string& regName) { 
-    auto it = registerMap.find(regName); 
-    if (it != registerMap.end()) {
-        return it->second; 
+    int reg = lookupRegister(regName);
+    if (reg >= 0) {
+        return reg; 
     }
     // Throw unknowns
     throw runtime_error("Unknown register: " + regName);
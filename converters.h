@@ -20,8 +20,51 @@
 
 
 #include <string>
+#include <string_view>
 #include <cstdint> 
 
+// Every mnemonic the encoder recognizes, in or out of project scope
+enum class Mnemonic : uint8_t {
+    // R-type (funct codes)
+    Sll, Srl, Jr, Mult, Div, Add, Sub, And, Or, Nor, Slt,
+    // I-type and J-type (opcodes)
+    J, Jal, Beq, Bne, Addi, Slti, Andi, Ori, Xori, Lb, Lw, Sb, Sw,
+    Unknown
+};
+
+/**
+ * Packs a name of up to four characters and its length into one integer,
+ * first character in the low byte. Used as a switch key so lookups need no hashing, no
+ * allocation and no table built at startup.
+ *
+ * @param name - Mnemonic or register name without the '$'
+ * @return Packed key, or 0 if the name is empty or longer than 4 chars
+ */
+constexpr uint64_t packName(std::string_view name) {
+    if (name.empty() || name.size() > 4)
+        return 0;
+    uint64_t key = static_cast<uint64_t>(name.size()) << 32;
+    for (size_t i = 0; i < name.size(); ++i)
+        key |= static_cast<uint64_t>(static_cast<unsigned char>(name[i])) << (8 * i);
+    return key;
+}
+
+/**
+ * Looks up an instruction mnemonic.
+ *
+ * @param op - Operation text, e.g. "addi"
+ * @return Matching Mnemonic, or Mnemonic::Unknown
+ */
+Mnemonic lookupMnemonic(std::string_view op);
+
+/**
+ * Looks up a register name without throwing.
+ *
+ * @param regName - Register name, must start with '$'
+ * @return Register number (0-31), or -1 if unknown
+ */
+int lookupRegister(std::string_view regName);
+
 /**
  * Converts a register name into its numeric value. 
  *
@@ -0,0 +1,71 @@
+/*------------------------------------------------------------------------------
+  File:        disassembler.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements instruction word to assembly text conversion
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+------------------------------------------------------------------------------*/
+
+#include "disassembler.h"
+#include <sstream>
+
+using namespace std;
+
+string namedRegister(uint32_t reg) {
+    static const char* const names[32] = {
+        "$zero", "$at", "$v0", "$v1", "$a0", "$a1", "$a2", "$a3",
+        "$t0",   "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
+        "$s0",   "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+        "$t8",   "$t9", "$k0", "$k1", "$gp", "$sp", "$fp", "$ra"
+    };
+    if (reg < 32)
+        return names[reg];
+    // Fallback
+    return "$r" + to_string(reg);
+}
+
+string disassembleInstruction(uint32_t instruction, uint32_t pc) {
+    uint32_t opcode = instruction >> 26;
+    uint32_t rs = (instruction >> 21) & 0x1F;
+    uint32_t rt = (instruction >> 16) & 0x1F;
+    uint32_t rd = (instruction >> 11) & 0x1F;
+    int16_t imm = static_cast<int16_t>(instruction & 0xFFFF);
+    ostringstream text;
+
+    if (opcode == 0) {
+        const char* name = nullptr;
+        switch (instruction & 0x3F) {
+            case 0x20: name = "add"; break;
+            case 0x22: name = "sub"; break;
+            case 0x24: name = "and"; break;
+            case 0x25: name = "or"; break;
+            case 0x27: name = "nor"; break;
+            case 0x2A: name = "slt"; break;
+        }
+        if (name) {
+            text << name << ' ' << namedRegister(rd) << ", " << namedRegister(rs)
+                 << ", " << namedRegister(rt);
+            return text.str();
+        }
+    } else if (opcode == 2 || opcode == 3) {
+        text << "j " << ((pc & 0xF0000000) | ((instruction & 0x03FFFFFF) << 2));
+        return text.str();
+    } else if (opcode == 0x04) {
+        text << "beq " << namedRegister(rs) << ", " << namedRegister(rt) << ", "
+             << pc + 4 + (static_cast<uint32_t>(int32_t(imm)) << 2);
+        return text.str();
+    } else if (opcode == 0x08) {
+        text << "addi " << namedRegister(rt) << ", " << namedRegister(rs) << ", " << imm;
+        return text.str();
+    } else if (opcode == 0x23 || opcode == 0x2B) {
+        text << (opcode == 0x23 ? "lw " : "sw ") << namedRegister(rt)
+             << ", " << imm << '(' << namedRegister(rs) << ')';
+        return text.str();
+    }
+
+    text << ".word 0x" << hex << instruction;
+    return text.str();
+}
@@ -0,0 +1,43 @@
+/*------------------------------------------------------------------------------
+  File:        disassembler.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the helpers that turn raw instruction words back into
+               assembly text for traces and the offline trace decoder.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Covers the instructions the simulator implements. beq and j
+               are printed with their resolved target pc, and any other word
+               is printed as ".word 0x...".
+
+  Dependencies:
+    - <string>, <cstdint>
+  -----------------------------------------------------------------------------*/
+#ifndef DISASSEMBLER_H
+#define DISASSEMBLER_H
+
+#include <string>
+#include <cstdint>
+
+/**
+ * Maps a register number to its assembly name.
+ *
+ * @param reg - Register number (0-31)
+ * @return Name such as "$t0", or "$r<n>" outside the register file
+ */
+std::string namedRegister(uint32_t reg);
+
+/**
+ * Disassembles one instruction word.
+ *
+ * @param instruction - Raw 32-bit instruction
+ * @param pc          - Address of the instruction (used for beq/j targets)
+ * @return Assembly text, e.g. "sw $t2, 0($zero)"
+ */
+std::string disassembleInstruction(uint32_t instruction, uint32_t pc);
+
+#endif // DISASSEMBLER_H
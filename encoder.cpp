@@ -12,47 +12,39 @@
   Dependencies:
     - encoder.h
     - converters.h
-    - <sstream>, <unordered_map>, <cstdint>
+    - <sstream>, <unordered_map>, <cstdint>, <climits>, <cctype>, <stdexcept>
   -----------------------------------------------------------------------------*/
 #include "encoder.h" 
 #include "converters.h"
 #include <sstream> 
 #include <unordered_map>
 #include <cstdint>
+#include <climits>
+#include <cctype>
+#include <stdexcept>
 
 using namespace std;
 
-// R-type mapper of operations to their funct codes to get ops
-static unordered_map<string, uint32_t> functMap = {
-    {"sll",  0x00},
-    {"srl",  0x02},
-    {"jr",   0x08},
-    {"mult", 0x18},
-    {"div",  0x1A},
-    {"add",  0x20},
-    {"sub",  0x22}, 
-    {"and",  0x24},
-    {"or",   0x25},
-    {"nor",  0x27},
-    {"slt",  0x2A}
+// Funct code (R-type) or opcode (I/J-type) for each Mnemonic, in enum order
+static constexpr uint32_t mnemonicCodes[] = {
+    // sll, srl, jr, mult, div
+    0x00, 0x02, 0x08, 0x18, 0x1A,
+    // add, sub, and, or, nor, slt
+    0x20, 0x22, 0x24, 0x25, 0x27, 0x2A,
+    // j, jal, beq, bne
+    0x02, 0x03, 0x04, 0x05,
+    // addi, slti, andi, ori, xori
+    0x08, 0x0A, 0x0C, 0x0D, 0x0E,
+    // lb, lw, sb, sw
+    0x20, 0x23, 0x28, 0x2B
 };
 
-// Opcode mapper for instructions I-Type and J-Type
-static unordered_map<string, uint32_t> opcodeMap = {
-    {"j",    0x02},
-    {"jal",  0x03},
-    {"beq",  0x04},
-    {"bne",  0x05},
-    {"addi", 0x08},
-    {"slti", 0x0A},
-    {"andi", 0x0C},
-    {"ori",  0x0D},
-    {"xori", 0x0E},
-    {"lb",   0x20},
-    {"lw",   0x23},
-    {"sb",   0x28},
-    {"sw",   0x2B}
-};
+static_assert(sizeof(mnemonicCodes) / sizeof(mnemonicCodes[0]) == static_cast<size_t>(Mnemonic::Unknown),
+              "mnemonicCodes must have one entry per Mnemonic");
+
+static constexpr uint32_t mnemonicCode(Mnemonic mnemonic) {
+    return mnemonicCodes[static_cast<size_t>(mnemonic)];
+}
 
 // Encodes an R-type instruction: opcode | rs | rt | rd | shamt | funct
 uint32_t encode_R(uint32_t funct, uint32_t rs, uint32_t rt, uint32_t rd) { 
@@ -70,82 +62,199 @@ uint32_t encode_J(uint32_t opcode, uint32_t address) {
     return (opcode << 26) | (address & 0x03FFFFFF);
 }
 
-// Assembles parsed tokens into 32-bit binary strings using the appropriate encoding function.
-vector<string> assemble(const vector<Token>& tokens, 
-                          const unordered_map<string, uint32_t>& symbolTable) {
-    vector<string> binaryInstructions;
-    uint32_t pc = 0;
+// Register operand to number; throws on unknown names
+static uint32_t registerOperand(string_view name) {
+    int reg = lookupRegister(name);
+    if (reg < 0) throw runtime_error("Unknown register: " + string(name));
+    return static_cast<uint32_t>(reg);
+}
 
-    for (const Token& token : tokens) {
-        const string& op = token.op; 
-        const vector<string>& args = token.args;
-        uint32_t encoded = 0; 
+// Same result and exceptions as std::stoi, without building a std::string
+static int integerOperand(string_view text) {
+    size_t i = 0;
+    while (i < text.size() && isspace(static_cast<unsigned char>(text[i])))
+        ++i;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+        negative = text[i++] == '-';
+    if (i == text.size() || !isdigit(static_cast<unsigned char>(text[i])))
+        throw invalid_argument("stoi");
 
-        if (functMap.count(op)) {
-          
-            // R-type: add rd, rs, rt
-            if (args.size() != 3) throw runtime_error("Invalid R-type instruction format");
-            uint32_t rd = reg_number(args[0]);
-            uint32_t rs = reg_number(args[1]); 
-            uint32_t rt = reg_number(args[2]);
-            encoded = encode_R(functMap[op], rs, rt, rd);
+    long long value = 0;
+    for (; i < text.size() && isdigit(static_cast<unsigned char>(text[i])); ++i) {
+        value = value * 10 + (text[i] - '0');
+        if (value > static_cast<long long>(INT_MAX) + 1)
+            throw out_of_range("stoi");
+    }
+    value = negative ? -value : value;
+    if (value > INT_MAX)
+        throw out_of_range("stoi");
+    return static_cast<int>(value);
+}
+
+/**
+ * Shared encoder for Token and TokenView. findLabel(i) looks up operand i as
+ * a label and returns a pointer to its address or nullptr; the caller reads
+ * the operand from its own token, so it never has to match views. Labels
+ * missing from the table either throw or, when unresolvedLabel is given,
+ * are reported there and encoded as 0.
+ */
+template <typename FindLabel>
+static uint32_t encodeOperands(string_view op, const string_view* args, size_t argCount,
+                               uint32_t pc, const FindLabel& findLabel,
+                               string_view* unresolvedLabel) {
+    uint32_t encoded = 0; 
+    // One switch on the packed name instead of string hashing and compares
+    Mnemonic mnemonic = lookupMnemonic(op);
+
+    if (mnemonic <= Mnemonic::Slt) {
+      
+        // R-type: add rd, rs, rt
+        if (argCount != 3) throw runtime_error("Invalid R-type instruction format");
+        uint32_t rd = registerOperand(args[0]);
+        uint32_t rs = registerOperand(args[1]); 
+        uint32_t rt = registerOperand(args[2]);
+        encoded = encode_R(mnemonicCode(mnemonic), rs, rt, rd);
+    }
+    else if (mnemonic != Mnemonic::Unknown) {
+        uint32_t opcode = mnemonicCode(mnemonic);
+
+        if (mnemonic == Mnemonic::Lw || mnemonic == Mnemonic::Sw) {
+            // Format: lw rt, offset(rs)
+            if (argCount != 2) throw runtime_error("Invalid format for lw/sw");
+            uint32_t rt = registerOperand(args[0]); 
+            size_t lparen = args[1].find('(');  
+            size_t rparen = args[1].find(')');
+            // Throw 
+            if (lparen == string_view::npos || rparen == string_view::npos)
+                throw runtime_error("Invalid memory access format"); 
+
+            int16_t offset = integerOperand(args[1].substr(0, lparen)); 
+            uint32_t rs = registerOperand(args[1].substr(lparen + 1, rparen - lparen - 1));
+            encoded = encode_I(opcode, rs, rt, offset); 
         }
-        else if (opcodeMap.count(op)) {
-            uint32_t opcode = opcodeMap[op];
-
-            if (op == "lw" || op == "sw") {
-                // Format: lw rt, offset(rs)
-                if (args.size() != 2) throw runtime_error("Invalid format for lw/sw");
-                uint32_t rt = reg_number(args[0]); 
-                size_t lparen = args[1].find('(');  
-                size_t rparen = args[1].find(')');
-                // Throw 
-                if (lparen == string::npos || rparen == string::npos)
-                    throw runtime_error("Invalid memory access format"); 
-
-                int16_t offset = stoi(args[1].substr(0, lparen)); 
-                uint32_t rs = reg_number(args[1].substr(lparen + 1, rparen - lparen - 1));
-                encoded = encode_I(opcode, rs, rt, offset); 
-            }
-            else if (op == "beq") {
-              
-                // Format: beq rs, rt, label
-                if (args.size() != 3) throw runtime_error("Invalid beq format");
-                uint32_t rs = reg_number(args[0]); 
-                uint32_t rt = reg_number(args[1]); 
-                const string& label = args[2];
-
-                if (!symbolTable.count(label)) throw runtime_error("Undefined label: " + label);
-                int offset = (symbolTable.at(label) - (pc + 4)) / 4;
-                encoded = encode_I(opcode, rs, rt, static_cast<int16_t>(offset)); 
-            }
-            else if (op == "addi") {
-              
-                // Format: addi rt, rs, imm
-                if (args.size() != 3) throw runtime_error("Invalid addi format");
-                uint32_t rt = reg_number(args[0]);
-                uint32_t rs = reg_number(args[1]); 
-                int16_t imm = static_cast<int16_t>(stoi(args[2]));
-                encoded = encode_I(opcode, rs, rt, imm);
+        else if (mnemonic == Mnemonic::Beq) {
+          
+            // Format: beq rs, rt, label
+            if (argCount != 3) throw runtime_error("Invalid beq format");
+            uint32_t rs = registerOperand(args[0]); 
+            uint32_t rt = registerOperand(args[1]); 
+            string_view label = args[2];
+
+            const uint32_t* address = findLabel(2);
+            if (!address) {
+                if (!unresolvedLabel) throw runtime_error("Undefined label: " + string(label));
+                *unresolvedLabel = label;
+                return encode_I(opcode, rs, rt, 0);
             }
-            else if (op == "j") {
-              
-                // Format: j label
-                if (args.size() != 1) throw runtime_error("Invalid j format");
-                const string& label = args[0]; 
-                if (!symbolTable.count(label)) throw runtime_error("Undefined label: " + label);
-                uint32_t addr = symbolTable.at(label) >> 2;
-                encoded = encode_J(opcode, addr);
+            int offset = (*address - (pc + 4)) / 4;
+            encoded = encode_I(opcode, rs, rt, static_cast<int16_t>(offset)); 
+        }
+        else if (mnemonic == Mnemonic::Addi) {
+          
+            // Format: addi rt, rs, imm
+            if (argCount != 3) throw runtime_error("Invalid addi format");
+            uint32_t rt = registerOperand(args[0]);
+            uint32_t rs = registerOperand(args[1]); 
+            int16_t imm = static_cast<int16_t>(integerOperand(args[2]));
+            encoded = encode_I(opcode, rs, rt, imm);
+        }
+        else if (mnemonic == Mnemonic::J) {
+          
+            // Format: j label
+            if (argCount != 1) throw runtime_error("Invalid j format");
+            string_view label = args[0]; 
+            const uint32_t* address = findLabel(0);
+            if (!address) {
+                if (!unresolvedLabel) throw runtime_error("Undefined label: " + string(label));
+                *unresolvedLabel = label;
+                return encode_J(opcode, 0);
             }
-        // Covers the ops that are out of scope in the project
-        } else {
-            throw runtime_error("Operation: " + op + " not supported.\n");
+            uint32_t addr = *address >> 2;
+            encoded = encode_J(opcode, addr);
         }
+    // Covers the ops that are out of scope in the project
+    } else {
+        throw runtime_error("Operation: " + string(op) + " not supported.\n");
+    }
+    return encoded;
+}
 
-        // Convert encoded instruction to binary string and add to output
-        binaryInstructions.push_back(to_binary32(encoded));
+// Encodes one token at pc (see encodeOperands)
+uint32_t encodeInstruction(const Token& token, uint32_t pc,
+                           const unordered_map<string, uint32_t>& symbolTable,
+                           string* unresolvedLabel) {
+    // Every supported format has at most 3 operands; argCount catches the rest
+    string_view args[3];
+    size_t argCount = token.args.size();
+    for (size_t i = 0; i < argCount && i < 3; ++i)
+        args[i] = token.args[i];
+
+    // Look the operand's own std::string up instead of copying the view
+    auto findLabel = [&symbolTable, &token](size_t argIndex) -> const uint32_t* {
+        auto it = symbolTable.find(token.args[argIndex]);
+        return it == symbolTable.end() ? nullptr : &it->second;
+    };
+    string_view unresolved;
+    uint32_t encoded = encodeOperands(token.op, args, argCount, pc, findLabel,
+                                      unresolvedLabel ? &unresolved : nullptr);
+    if (unresolvedLabel && !unresolved.empty())
+        *unresolvedLabel = string(unresolved);
+    return encoded;
+}
+
+// Encodes one view token at pc against a LabelTable (see encodeOperands)
+uint32_t encodeInstruction(const TokenView& token, uint32_t pc, const LabelTable& labels) {
+    auto findLabel = [&labels, &token](size_t argIndex) { return labels.find(token.args[argIndex]); };
+    return encodeOperands(token.op, token.args, token.argCount, pc, findLabel, nullptr);
+}
+
+// Fills in the label field left at 0 by encodeInstruction
+uint32_t resolveLabelReference(uint32_t encoded, uint32_t pc, uint32_t labelAddress) {
+    uint32_t opcode = encoded >> 26;
+    if (opcode == mnemonicCode(Mnemonic::Beq)) {
+        int offset = (labelAddress - (pc + 4)) / 4;
+        return encoded | (static_cast<uint16_t>(offset) & 0xFFFF);
+    }
+    return encoded | ((labelAddress >> 2) & 0x03FFFFFF);
+}
+
+// Assembles parsed tokens into 32-bit machine words using the appropriate encoding function.
+vector<uint32_t> assembleWords(const vector<Token>& tokens,
+                               const unordered_map<string, uint32_t>& symbolTable) {
+    vector<uint32_t> machineWords;
+    machineWords.reserve(tokens.size());
+    uint32_t pc = 0;
+
+    for (const Token& token : tokens) {
+        machineWords.push_back(encodeInstruction(token, pc, symbolTable, nullptr));
+        pc += 4; 
+    }
+
+    return machineWords;
+}
+
+// Assembles view tokens straight from the source buffer into machine words
+vector<uint32_t> assembleWords(const vector<TokenView>& tokens, const LabelTable& labels) {
+    vector<uint32_t> machineWords;
+    machineWords.reserve(tokens.size());
+    uint32_t pc = 0;
+
+    for (const TokenView& token : tokens) {
+        machineWords.push_back(encodeInstruction(token, pc, labels));
         pc += 4; 
     }
 
+    return machineWords;
+}
+
+// Assembles parsed tokens into 32-bit binary strings using the appropriate encoding function.
+vector<string> assemble(const vector<Token>& tokens, 
+                          const unordered_map<string, uint32_t>& symbolTable) {
+    vector<string> binaryInstructions;
+    for (uint32_t encoded : assembleWords(tokens, symbolTable)) {
+        // Convert encoded instruction to binary string and add to output
+        binaryInstructions.push_back(to_binary32(encoded));
+    }
     return binaryInstructions; 
 } 
@@ -33,6 +33,65 @@
 std::vector<std::string> assemble(const std::vector<Token>& tokens,
                                   const std::unordered_map<std::string, uint32_t>& symbolTable);
 
+/**
+ * Converts a list of parsed MIPS tokens into raw 32-bit machine words.
+ *
+ * @param tokens - Parsed instructions of operators and operands
+ * @param symbolTable - Maps labels to addresses in branches or jumps
+ * @return vector of encoded instructions, one word per token
+ */
+std::vector<uint32_t> assembleWords(const std::vector<Token>& tokens,
+                                    const std::unordered_map<std::string, uint32_t>& symbolTable);
+
+/**
+ * Converts view tokens into raw 32-bit machine words without copying any
+ * operand text.
+ *
+ * @param tokens - Tokens from parseSource
+ * @param labels - Label table from parseSource
+ * @return vector of encoded instructions, one word per token
+ * @throws std::runtime_error on malformed or unsupported instructions
+ */
+std::vector<uint32_t> assembleWords(const std::vector<TokenView>& tokens, const LabelTable& labels);
+
+/**
+ * Encodes a single view token located at pc.
+ *
+ * @param token  - Token from parseSource
+ * @param pc     - Address of the instruction
+ * @param labels - Every label in the program
+ * @return Encoded 32-bit instruction
+ * @throws std::runtime_error on malformed or unsupported instructions or
+ *         an undefined label
+ */
+uint32_t encodeInstruction(const TokenView& token, uint32_t pc, const LabelTable& labels);
+
+/**
+ * Encodes a single parsed instruction located at pc.
+ *
+ * @param token           - Parsed instruction
+ * @param pc              - Address of the instruction
+ * @param symbolTable     - Labels defined so far
+ * @param unresolvedLabel - If not null, a beq/j label missing from the table
+ *                          is stored here and its field is encoded as 0
+ *                          instead of throwing
+ * @return Encoded 32-bit instruction
+ * @throws std::runtime_error on malformed or unsupported instructions
+ */
+uint32_t encodeInstruction(const Token& token, uint32_t pc,
+                           const std::unordered_map<std::string, uint32_t>& symbolTable,
+                           std::string* unresolvedLabel = nullptr);
+
+/**
+ * Patches a beq/j word encoded with an unresolved label.
+ *
+ * @param encoded      - Word returned by encodeInstruction
+ * @param pc           - Address of the instruction
+ * @param labelAddress - Address the label resolved to
+ * @return Word with the branch offset or jump target filled in
+ */
+uint32_t resolveLabelReference(uint32_t encoded, uint32_t pc, uint32_t labelAddress);
+
 /**
  * Encodes an R-type MIPS instruction into a 32-bit integer.
  *
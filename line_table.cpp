@@ -0,0 +1,113 @@
+/*------------------------------------------------------------------------------
+  File:        line_table.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Reads and writes the source line table and maps addresses
+               back to lines and labels.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - line_table.h
+    - <fstream>, <sstream>, <algorithm>, <stdexcept>
+  -----------------------------------------------------------------------------*/
+#include "line_table.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+const LineEntry* LineTable::find(uint32_t pc) const {
+    auto it = lower_bound(lines.begin(), lines.end(), pc,
+                          [](const LineEntry& entry, uint32_t value) { return entry.pc < value; });
+    return (it != lines.end() && it->pc == pc) ? &*it : nullptr;
+}
+
+const LineLabel* LineTable::labelFor(uint32_t pc) const {
+    auto it = upper_bound(labels.begin(), labels.end(), pc,
+                          [](uint32_t value, const LineLabel& label) { return value < label.pc; });
+    return it == labels.begin() ? nullptr : &*(it - 1);
+}
+
+string LineTable::describe(uint32_t pc) const {
+    ostringstream text;
+    const LineLabel* label = labelFor(pc);
+    if (label) {
+        text << label->name;
+        if (pc != label->pc)
+            text << "+0x" << hex << (pc - label->pc);
+    } else {
+        text << "0x" << hex << pc;
+    }
+    return text.str();
+}
+
+void writeLineTable(const string& path, const LineTable& table) {
+    ofstream out(path);
+    if (!out) {
+        throw runtime_error("Cannot open line table: " + path);
+    }
+    out << "TMLT " << LINE_TABLE_VERSION << '\n';
+    out << "source " << table.sourcePath << '\n';
+    out << hex;
+    for (const LineLabel& label : table.labels)
+        out << "label " << label.pc << ' ' << label.name << '\n';
+    for (const LineEntry& entry : table.lines)
+        out << "line " << entry.pc << ' ' << dec << entry.line << hex << ' ' << entry.text << '\n';
+    if (!out) {
+        throw runtime_error("Failed to write line table: " + path);
+    }
+}
+
+LineTable readLineTable(const string& path) {
+    ifstream in(path);
+    if (!in) {
+        throw runtime_error("Cannot open line table: " + path);
+    }
+    LineTable table;
+    string line;
+    size_t lineNumber = 0;
+    auto malformed = [&]() {
+        return runtime_error("Malformed line table " + path + " at line " + to_string(lineNumber));
+    };
+    while (getline(in, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        istringstream fields(line);
+        string kind;
+        fields >> kind;
+        if (lineNumber == 1) {
+            uint32_t version = 0;
+            if (kind != "TMLT" || !(fields >> version) || version != LINE_TABLE_VERSION)
+                throw runtime_error("Not a version " + to_string(LINE_TABLE_VERSION) + " line table: " + path);
+        } else if (kind == "source") {
+            getline(fields >> ws, table.sourcePath);
+        } else if (kind == "label") {
+            LineLabel label;
+            if (!(fields >> hex >> label.pc >> label.name))
+                throw malformed();
+            table.labels.push_back(label);
+        } else if (kind == "line") {
+            LineEntry entry;
+            if (!(fields >> hex >> entry.pc >> dec >> entry.line))
+                throw malformed();
+            getline(fields >> ws, entry.text);
+            table.lines.push_back(entry);
+        } else if (!kind.empty()) {
+            throw malformed();
+        }
+    }
+    if (lineNumber == 0) {
+        throw runtime_error("Empty line table: " + path);
+    }
+    // Written sorted; stable so duplicate labels keep their order
+    auto byPc = [](const auto& a, const auto& b) { return a.pc < b.pc; };
+    stable_sort(table.labels.begin(), table.labels.end(), byPc);
+    stable_sort(table.lines.begin(), table.lines.end(), byPc);
+    return table;
+}
@@ -0,0 +1,81 @@
+/*------------------------------------------------------------------------------
+  File:        line_table.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the source line table the assembler can write next
+               to its output, and the simulator reads back for profiling.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               A line table is a text file, one entry per line:
+
+                   TMLT 1                    header and format version
+                   source PATH               the assembled source file
+                   label PC NAME             a label and its address
+                   line PC LINE TEXT         an instruction, its 1-based
+                                             source line and its text
+
+               PC is hexadecimal, entries are sorted by pc. The assembler
+               writes it to OUTPUT.lines when run with -g.
+
+  Dependencies:
+    - <string>, <vector>, <cstdint>
+  -----------------------------------------------------------------------------*/
+#ifndef LINE_TABLE_H
+#define LINE_TABLE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Current line table format version
+const uint32_t LINE_TABLE_VERSION = 1;
+
+// One assembled instruction and where it came from
+struct LineEntry {
+    uint32_t pc;
+    uint32_t line;
+    std::string text;
+};
+
+struct LineLabel {
+    uint32_t pc;
+    std::string name;
+};
+
+struct LineTable {
+    std::string sourcePath;
+    // Both sorted by pc
+    std::vector<LineEntry> lines;
+    std::vector<LineLabel> labels;
+
+    // Entry for an instruction address, or nullptr if there is none
+    const LineEntry* find(uint32_t pc) const;
+    // Closest label at or before pc, or nullptr
+    const LineLabel* labelFor(uint32_t pc) const;
+    // "label+0x8" style name for pc, or the pc in hex without labels
+    std::string describe(uint32_t pc) const;
+};
+
+/**
+ * Writes a line table.
+ *
+ * @param path  - Destination file path
+ * @param table - Entries to write (sorted by pc)
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeLineTable(const std::string& path, const LineTable& table);
+
+/**
+ * Reads a line table written by writeLineTable.
+ *
+ * @param path - Line table path
+ * @return The decoded table
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+LineTable readLineTable(const std::string& path);
+
+#endif // LINE_TABLE_H
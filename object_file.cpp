@@ -0,0 +1,218 @@
+/*------------------------------------------------------------------------------
+  File:        object_file.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements writing and memory-mapped reading of the packed
+               binary object format.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - object_file.h
+    - <fstream>, <algorithm>, <cstring>, <stdexcept>
+    - POSIX mmap (<sys/mman.h>, <sys/stat.h>, <fcntl.h>, <unistd.h>)
+  -----------------------------------------------------------------------------*/
+#include "object_file.h"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const char OBJECT_MAGIC[4] = {'T', 'M', 'O', 'B'};
+
+// Endianness of the machine running the tools
+static uint8_t hostEndianness() {
+    const uint16_t probe = 1;
+    uint8_t firstByte;
+    memcpy(&firstByte, &probe, 1);
+    return firstByte == 1 ? OBJECT_LITTLE_ENDIAN : OBJECT_BIG_ENDIAN;
+}
+
+static uint16_t swap16(uint16_t v) {
+    return static_cast<uint16_t>((v >> 8) | (v << 8));
+}
+
+static uint32_t swap32(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0x0000FF00) | ((v << 8) & 0x00FF0000) | (v << 24);
+}
+
+// Rounds a byte count up to the next 4-byte boundary
+static uint32_t align4(uint32_t n) {
+    return (n + 3) & ~3u;
+}
+
+/**
+ * Writes the header, text words and symbols in host byte order. Symbols are
+ * sorted by address and name so identical sources give identical files.
+ */
+void writeObjectFile(const string& path, const vector<uint32_t>& text,
+                     const unordered_map<string, uint32_t>& symbolTable) {
+    ObjectFileWriter writer(path);
+    for (uint32_t word : text) {
+        writer.appendWord(word);
+    }
+    writer.finish(symbolTable);
+}
+
+ObjectFileWriter::ObjectFileWriter(const string& path)
+    : out(path, ios::binary), path(path), count(0) {
+    if (!out) {
+        throw runtime_error("Cannot open output file: " + path);
+    }
+    // Placeholder until finish() knows the counts
+    ObjectHeader header{};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void ObjectFileWriter::appendWord(uint32_t word) {
+    out.write(reinterpret_cast<const char*>(&word), sizeof(word));
+    ++count;
+}
+
+void ObjectFileWriter::patchWord(size_t index, uint32_t word) {
+    streampos end = out.tellp();
+    out.seekp(static_cast<streamoff>(sizeof(ObjectHeader) + index * 4));
+    out.write(reinterpret_cast<const char*>(&word), sizeof(word));
+    out.seekp(end);
+}
+
+void ObjectFileWriter::finish(const unordered_map<string, uint32_t>& symbolTable) {
+    vector<pair<uint32_t, string>> sortedSymbols;
+    sortedSymbols.reserve(symbolTable.size());
+    for (const auto& entry : symbolTable) {
+        sortedSymbols.push_back({entry.second, entry.first});
+    }
+    sort(sortedSymbols.begin(), sortedSymbols.end());
+
+    static const char padding[4] = {0, 0, 0, 0};
+    for (const auto& symbol : sortedSymbols) {
+        uint32_t address = symbol.first;
+        uint32_t nameLength = static_cast<uint32_t>(symbol.second.size());
+        out.write(reinterpret_cast<const char*>(&address), sizeof(address));
+        out.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+        out.write(symbol.second.data(), nameLength);
+        out.write(padding, align4(nameLength) - nameLength);
+    }
+
+    ObjectHeader header{};
+    memcpy(header.magic, OBJECT_MAGIC, sizeof(OBJECT_MAGIC));
+    header.version = OBJECT_FORMAT_VERSION;
+    header.endianness = hostEndianness();
+    header.textCount = count;
+    header.symbolCount = static_cast<uint32_t>(sortedSymbols.size());
+    header.textOffset = sizeof(ObjectHeader);
+    header.symbolOffset = header.textOffset + header.textCount * 4;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.flush();
+
+    if (!out) {
+        throw runtime_error("Failed writing object file: " + path);
+    }
+}
+
+bool isObjectFile(const string& path) {
+    ifstream in(path, ios::binary);
+    char magic[4] = {0, 0, 0, 0};
+    in.read(magic, sizeof(magic));
+    return in && memcmp(magic, OBJECT_MAGIC, sizeof(OBJECT_MAGIC)) == 0;
+}
+
+ObjectFile::ObjectFile(const string& path)
+    : mapping(nullptr), mappingSize(0), header{}, swapped(false), textWords(nullptr) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Cannot open file " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ObjectHeader)) {
+        close(fd);
+        throw runtime_error("Object file too small: " + path);
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw runtime_error("Cannot map object file " + path);
+    }
+
+    memcpy(&header, mapping, sizeof(header));
+    if (memcmp(header.magic, OBJECT_MAGIC, sizeof(OBJECT_MAGIC)) != 0) {
+        unmap();
+        throw runtime_error("Not a Tiny MIPS object file: " + path);
+    }
+
+    swapped = header.endianness != hostEndianness();
+    if (swapped) {
+        header.version = swap16(header.version);
+        header.textCount = swap32(header.textCount);
+        header.symbolCount = swap32(header.symbolCount);
+        header.textOffset = swap32(header.textOffset);
+        header.symbolOffset = swap32(header.symbolOffset);
+    }
+
+    uint64_t textEnd = static_cast<uint64_t>(header.textOffset) + uint64_t(header.textCount) * 4;
+    if (header.version != OBJECT_FORMAT_VERSION || header.textOffset % 4 != 0
+            || textEnd > mappingSize || header.symbolOffset > mappingSize) {
+        unmap();
+        throw runtime_error("Unsupported or corrupt object file: " + path);
+    }
+
+    const uint32_t* mappedText = reinterpret_cast<const uint32_t*>(
+        static_cast<const uint8_t*>(mapping) + header.textOffset);
+    if (swapped) {
+        swappedText.resize(header.textCount);
+        for (uint32_t i = 0; i < header.textCount; ++i) {
+            swappedText[i] = swap32(mappedText[i]);
+        }
+        textWords = swappedText.data();
+    } else {
+        textWords = mappedText;
+    }
+}
+
+ObjectFile::~ObjectFile() {
+    unmap();
+}
+
+void ObjectFile::unmap() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+    }
+}
+
+vector<ObjectSymbol> ObjectFile::symbols() const {
+    vector<ObjectSymbol> result;
+    const uint8_t* base = static_cast<const uint8_t*>(mapping);
+    size_t offset = header.symbolOffset;
+
+    for (uint32_t i = 0; i < header.symbolCount; ++i) {
+        uint32_t address;
+        uint32_t nameLength;
+        if (offset + 8 > mappingSize)
+            throw runtime_error("Truncated symbol section");
+        memcpy(&address, base + offset, 4);
+        memcpy(&nameLength, base + offset + 4, 4);
+        if (swapped) {
+            address = swap32(address);
+            nameLength = swap32(nameLength);
+        }
+        offset += 8;
+        if (offset + nameLength > mappingSize)
+            throw runtime_error("Truncated symbol section");
+        result.push_back({string(reinterpret_cast<const char*>(base + offset), nameLength), address});
+        offset += align4(nameLength);
+    }
+    return result;
+}
@@ -0,0 +1,143 @@
+/*------------------------------------------------------------------------------
+  File:        object_file.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the packed binary object format shared by the assembler
+               (writer) and the CPU simulator (memory-mapped reader).
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Layout of a version 1 object file (all offsets in bytes):
+
+               | 0-3   | magic "TMOB"                              |
+               | 4-5   | format version                            |
+               | 6     | endianness of every multi-byte field      |
+               | 7     | reserved (0)                              |
+               | 8-11  | text word count                           |
+               | 12-15 | symbol count                              |
+               | 16-19 | text section offset (4-byte aligned)      |
+               | 20-23 | symbol section offset                     |
+
+               The text section is an array of raw 32-bit instruction words.
+               Each symbol entry is a 32-bit address, a 32-bit name length
+               and the name bytes, padded to the next 4-byte boundary.
+
+  Dependencies:
+    - <string>, <vector>, <unordered_map>, <fstream>, <cstdint>, <cstddef>
+  -----------------------------------------------------------------------------*/
+#ifndef OBJECT_FILE_H
+#define OBJECT_FILE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+
+// Current object format version written by the assembler
+const uint16_t OBJECT_FORMAT_VERSION = 1;
+
+// Endianness flag values stored in the header
+const uint8_t OBJECT_LITTLE_ENDIAN = 0;
+const uint8_t OBJECT_BIG_ENDIAN = 1;
+
+// Fixed-size header at the start of every object file
+struct ObjectHeader {
+    char magic[4];
+    uint16_t version;
+    uint8_t endianness;
+    uint8_t reserved;
+    uint32_t textCount;
+    uint32_t symbolCount;
+    uint32_t textOffset;
+    uint32_t symbolOffset;
+};
+
+// Label and address pair read back from the symbol section
+struct ObjectSymbol {
+    std::string name;
+    uint32_t address;
+};
+
+/**
+ * Writes instruction words and the symbol table as a binary object file.
+ *
+ * @param path        - Destination file path
+ * @param text        - Encoded 32-bit instruction words
+ * @param symbolTable - Labels and their instruction addresses
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeObjectFile(const std::string& path, const std::vector<uint32_t>& text,
+                     const std::unordered_map<std::string, uint32_t>& symbolTable);
+
+/**
+ * Writes an object file one word at a time. The header is reserved up front
+ * and filled in by finish(), once the word and symbol counts are known.
+ * Words already written can be patched, which the streaming assembler uses
+ * for forward label references.
+ */
+class ObjectFileWriter {
+public:
+    // Creates or truncates the file; throws std::runtime_error
+    explicit ObjectFileWriter(const std::string& path);
+
+    ObjectFileWriter(const ObjectFileWriter&) = delete;
+    ObjectFileWriter& operator=(const ObjectFileWriter&) = delete;
+
+    void appendWord(uint32_t word);
+    // Overwrites a word that was already appended
+    void patchWord(size_t index, uint32_t word);
+    // Writes the symbol section and the final header; throws std::runtime_error
+    void finish(const std::unordered_map<std::string, uint32_t>& symbolTable);
+    size_t wordCount() const { return count; }
+
+private:
+    std::ofstream out;
+    std::string path;
+    uint32_t count;
+};
+
+/**
+ * Checks the leading magic bytes to tell object files from bitstring text.
+ *
+ * @param path - File to inspect
+ * @return true if the file starts with the object file magic
+ */
+bool isObjectFile(const std::string& path);
+
+/**
+ * Read-only view of an object file. The file is memory-mapped so the text
+ * section can be handed to the CPU without parsing. Files written on a host
+ * of the other endianness are byte-swapped into a private copy instead.
+ */
+class ObjectFile {
+public:
+    // Maps the file and validates the header; throws std::runtime_error
+    explicit ObjectFile(const std::string& path);
+    ~ObjectFile();
+
+    ObjectFile(const ObjectFile&) = delete;
+    ObjectFile& operator=(const ObjectFile&) = delete;
+
+    // Instruction words in host byte order
+    const uint32_t* text() const { return textWords; }
+    size_t textCount() const { return header.textCount; }
+    // Symbol section decoded into name and address pairs
+    std::vector<ObjectSymbol> symbols() const;
+
+private:
+    void unmap();
+
+    void* mapping;
+    size_t mappingSize;
+    ObjectHeader header;
+    bool swapped;
+    const uint32_t* textWords;
+    std::vector<uint32_t> swappedText;
+};
+
+#endif // OBJECT_FILE_H
@@ -0,0 +1,136 @@
+/*------------------------------------------------------------------------------
+  File:        paged_memory.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements page lookup, first-touch allocation and the slow
+               load/store paths of the sparse data memory.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - paged_memory.h
+    - <cstring>, <algorithm>
+  -----------------------------------------------------------------------------*/
+#include "paged_memory.h"
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+// Page numbers are 20 bits, so this never matches a real page
+static const uint32_t NO_PAGE = 0xFFFFFFFF;
+
+// Byte order of the machine running the simulator
+static Endianness hostEndianness() {
+    const uint16_t probe = 1;
+    uint8_t firstByte;
+    memcpy(&firstByte, &probe, 1);
+    return firstByte == 1 ? Endianness::Little : Endianness::Big;
+}
+
+PagedMemory::PagedMemory()
+    : directory(TABLE_SIZE), resident(0), lastNumber(NO_PAGE), lastPage(nullptr) {
+    setEndianness(Endianness::Big);
+}
+
+void PagedMemory::setEndianness(Endianness selected) {
+    order = selected;
+    swapWords = order != hostEndianness();
+}
+
+uint8_t* PagedMemory::lookup(uint32_t pageNumber) const {
+    const unique_ptr<PageTable>& table = directory[pageNumber >> TABLE_BITS];
+    if (!table)
+        return nullptr;
+    return table->pages[pageNumber & (TABLE_SIZE - 1)].get();
+}
+
+uint8_t* PagedMemory::allocate(uint32_t pageNumber) {
+    unique_ptr<PageTable>& table = directory[pageNumber >> TABLE_BITS];
+    if (!table)
+        table.reset(new PageTable());
+    unique_ptr<uint8_t[]>& page = table->pages[pageNumber & (TABLE_SIZE - 1)];
+    if (!page) {
+        page.reset(new uint8_t[PAGE_SIZE]());
+        ++resident;
+    }
+    return page.get();
+}
+
+const uint8_t* PagedMemory::findPage(uint32_t pageNumber) const {
+    return lookup(pageNumber);
+}
+
+uint8_t PagedMemory::loadByte(uint32_t address) const {
+    const uint8_t* page = lookup(address >> PAGE_BITS);
+    return page ? page[address & (PAGE_SIZE - 1)] : 0;
+}
+
+void PagedMemory::storeByte(uint32_t address, uint8_t value) {
+    allocate(address >> PAGE_BITS)[address & (PAGE_SIZE - 1)] = value;
+}
+
+uint32_t PagedMemory::loadWordSlow(uint32_t address) const {
+    if ((address & 3) == 0) {
+        uint8_t* page = lookup(address >> PAGE_BITS);
+        if (!page)
+            return 0;
+        lastNumber = address >> PAGE_BITS;
+        lastPage = page;
+        return loadWord(address);
+    }
+    // Unaligned - may straddle two pages or wrap around the top of the
+    // address space, so each byte is looked up on its own
+    uint32_t word = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        uint32_t shift = (order == Endianness::Big) ? 24 - 8 * i : 8 * i;
+        word |= uint32_t(loadByte(address + i)) << shift;
+    }
+    return word;
+}
+
+void PagedMemory::storeWordSlow(uint32_t address, uint32_t value) {
+    if ((address & 3) == 0) {
+        lastPage = allocate(address >> PAGE_BITS);
+        lastNumber = address >> PAGE_BITS;
+        storeWord(address, value);
+        return;
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+        uint32_t shift = (order == Endianness::Big) ? 24 - 8 * i : 8 * i;
+        storeByte(address + i, uint8_t(value >> shift));
+    }
+}
+
+void PagedMemory::write(uint32_t address, const uint8_t* bytes, size_t size) {
+    while (size > 0) {
+        uint32_t offset = address & (PAGE_SIZE - 1);
+        size_t chunk = min<size_t>(size, PAGE_SIZE - offset);
+        memcpy(allocate(address >> PAGE_BITS) + offset, bytes, chunk);
+        address += static_cast<uint32_t>(chunk);
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+void PagedMemory::clear() {
+    for (unique_ptr<PageTable>& table : directory)
+        table.reset();
+    resident = 0;
+    lastNumber = NO_PAGE;
+    lastPage = nullptr;
+}
+
+void PagedMemory::forEachPage(const function<void(uint32_t, const uint8_t*)>& visit) const {
+    for (uint32_t top = 0; top < TABLE_SIZE; ++top) {
+        if (!directory[top])
+            continue;
+        for (uint32_t low = 0; low < TABLE_SIZE; ++low) {
+            const uint8_t* page = directory[top]->pages[low].get();
+            if (page)
+                visit((top << TABLE_BITS) | low, page);
+        }
+    }
+}
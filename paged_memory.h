@@ -0,0 +1,135 @@
+/*------------------------------------------------------------------------------
+  File:        paged_memory.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the sparse paged data memory behind TinyMipsCPU's
+               lw and sw instructions.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Covers the full 32-bit guest address space with 4 KiB pages
+               that are allocated, zero-filled, on the first store to them.
+               Loads from a page that was never stored to read 0 and
+               allocate nothing. A 20-bit page number is split 10/10 over a
+               two-level table, so a lookup is two indexed loads.
+
+               The load/store fast path is inline: an aligned word in the
+               last resident page touched (a one-entry cache) is one 32-bit
+               host load or store, byte-swapped when the guest byte order
+               differs from the host's. Cache misses and the first touch of
+               a page go through the out-of-line path; unaligned words,
+               which may straddle two pages, are assembled a byte at a time.
+
+               Words are big-endian by default, as in the original flat
+               memory, and either order can be selected per memory.
+
+  Dependencies:
+    - <cstdint>, <cstddef>, <memory>, <vector>, <functional>, <cstring>
+  -----------------------------------------------------------------------------*/
+#ifndef PAGED_MEMORY_H
+#define PAGED_MEMORY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <cstring>
+
+// Byte order of the guest words held in memory
+enum class Endianness { Big, Little };
+
+class PagedMemory {
+public:
+    static const uint32_t PAGE_BITS = 12;
+    static const uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+
+    PagedMemory();
+
+    PagedMemory(const PagedMemory&) = delete;
+    PagedMemory& operator=(const PagedMemory&) = delete;
+
+    // Byte order used by loadWord and storeWord (big-endian by default).
+    // Bytes already in memory are not rearranged.
+    void setEndianness(Endianness order);
+    Endianness endianness() const { return order; }
+
+    // Word at any address in the guest byte order (it may straddle two pages)
+    uint32_t loadWord(uint32_t address) const {
+        // Aligned words never cross a page
+        if ((address & 3) == 0 && (address >> PAGE_BITS) == lastNumber) {
+            uint32_t word;
+            memcpy(&word, lastPage + (address & (PAGE_SIZE - 1)), sizeof(word));
+            return swapWords ? swapBytes(word) : word;
+        }
+        return loadWordSlow(address);
+    }
+
+    void storeWord(uint32_t address, uint32_t value) {
+        if ((address & 3) == 0 && (address >> PAGE_BITS) == lastNumber) {
+            uint32_t word = swapWords ? swapBytes(value) : value;
+            memcpy(lastPage + (address & (PAGE_SIZE - 1)), &word, sizeof(word));
+            return;
+        }
+        storeWordSlow(address, value);
+    }
+
+    uint8_t loadByte(uint32_t address) const;
+    void storeByte(uint32_t address, uint8_t value);
+
+    /**
+     * Copies a block into memory, allocating the pages it covers.
+     *
+     * @param address - First byte written
+     * @param bytes   - Data to copy
+     * @param size    - Byte count; the block wraps past 0xFFFFFFFF
+     */
+    void write(uint32_t address, const uint8_t* bytes, size_t size);
+
+    // Frees every page, so all of memory reads as zero again
+    void clear();
+
+    // Pages allocated so far (each PAGE_SIZE bytes)
+    size_t residentPages() const { return resident; }
+    // Page contents, or nullptr if the page was never stored to
+    const uint8_t* findPage(uint32_t pageNumber) const;
+    // Calls visit(pageNumber, bytes) for every resident page in address order
+    void forEachPage(const std::function<void(uint32_t, const uint8_t*)>& visit) const;
+
+private:
+    static const uint32_t TABLE_BITS = 10;
+    static const uint32_t TABLE_SIZE = 1u << TABLE_BITS;
+
+    // Second level: TABLE_SIZE consecutive pages
+    struct PageTable {
+        std::unique_ptr<uint8_t[]> pages[TABLE_SIZE];
+    };
+
+    static uint32_t swapBytes(uint32_t word) {
+#if defined(__GNUC__)
+        return __builtin_bswap32(word);
+#else
+        return (word >> 24) | ((word >> 8) & 0x0000FF00) | ((word << 8) & 0x00FF0000) | (word << 24);
+#endif
+    }
+
+    uint8_t* lookup(uint32_t pageNumber) const;
+    uint8_t* allocate(uint32_t pageNumber);
+    uint32_t loadWordSlow(uint32_t address) const;
+    void storeWordSlow(uint32_t address, uint32_t value);
+
+    // First level, indexed by the top TABLE_BITS of the page number
+    std::vector<std::unique_ptr<PageTable>> directory;
+    size_t resident;
+    Endianness order;
+    // Guest and host byte order differ
+    bool swapWords;
+    // Last resident page touched; lastNumber never matches while it is unset
+    mutable uint32_t lastNumber;
+    mutable uint8_t* lastPage;
+};
+
+#endif // PAGED_MEMORY_H
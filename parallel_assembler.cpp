@@ -0,0 +1,141 @@
+/*------------------------------------------------------------------------------
+  File:        parallel_assembler.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements chunked, multi-threaded parsing and encoding
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - parallel_assembler.h, encoder.h, bitstring_codec.h
+    - <thread>, <atomic>, <exception>, <functional>
+  -----------------------------------------------------------------------------*/
+#include "parallel_assembler.h"
+#include "encoder.h"
+#include "bitstring_codec.h"
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <functional>
+
+using namespace std;
+
+// Chunks per thread - more than one so a slow chunk doesn't stall the rest
+static const size_t CHUNKS_PER_THREAD = 4;
+// Below this a chunk is not worth a thread
+static const size_t MIN_CHUNK_BYTES = 64 * 1024;
+
+/**
+ * Runs work(i) for every i in [0, count) on up to threads threads, handing
+ * out indexes one at a time. The exception from the lowest failing index
+ * is rethrown after all threads have finished.
+ */
+static void parallelFor(size_t count, unsigned threads, const function<void(size_t)>& work) {
+    vector<exception_ptr> errors(count);
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            try {
+                work(i);
+            } catch (...) {
+                errors[i] = current_exception();
+            }
+        }
+    };
+
+    size_t workers = min<size_t>(threads, count);
+    vector<thread> pool;
+    for (size_t t = 1; t < workers; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (thread& t : pool)
+        t.join();
+
+    for (const exception_ptr& error : errors) {
+        if (error)
+            rethrow_exception(error);
+    }
+}
+
+// Cuts the source just after a '\n' near every chunk boundary
+static vector<string_view> splitLines(string_view source, size_t chunkCount) {
+    vector<string_view> pieces;
+    size_t target = source.size() / chunkCount + 1;
+    size_t start = 0;
+    while (start < source.size()) {
+        size_t end = start + target;
+        if (end >= source.size()) {
+            end = source.size();
+        } else {
+            end = source.find('\n', end);
+            end = (end == string_view::npos) ? source.size() : end + 1;
+        }
+        pieces.push_back(source.substr(start, end - start));
+        start = end;
+    }
+    return pieces;
+}
+
+vector<SourceChunk> parseParallel(string_view source, unsigned threads, LabelTable& labels) {
+    size_t chunkCount = max<size_t>(1, min(threads * CHUNKS_PER_THREAD,
+                                           source.size() / MIN_CHUNK_BYTES));
+    vector<string_view> pieces = splitLines(source, chunkCount);
+
+    vector<SourceChunk> chunks(pieces.size());
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        chunks[i].text = pieces[i];
+        chunks[i].arena.reset(new Arena());
+    }
+
+    // Tokenize every chunk as if it started at pc 0
+    parallelFor(chunks.size(), threads, [&chunks](size_t i) {
+        SourceChunk& chunk = chunks[i];
+        chunk.tokens = parseSource(chunk.text, *chunk.arena, chunk.labels);
+    });
+
+    // Prefix sum of instruction counts, then merge labels in source order
+    uint32_t pc = 0;
+    for (SourceChunk& chunk : chunks) {
+        chunk.basePc = pc;
+        labels.mergeFrom(chunk.labels, pc);
+        pc += static_cast<uint32_t>(chunk.tokens.size() * 4);
+    }
+    return chunks;
+}
+
+vector<uint32_t> encodeParallel(const vector<SourceChunk>& chunks, const LabelTable& labels,
+                                unsigned threads) {
+    size_t total = 0;
+    for (const SourceChunk& chunk : chunks)
+        total += chunk.tokens.size();
+    vector<uint32_t> words(total);
+
+    parallelFor(chunks.size(), threads, [&](size_t i) {
+        const SourceChunk& chunk = chunks[i];
+        uint32_t pc = chunk.basePc;
+        uint32_t* out = words.data() + pc / 4;
+        for (const TokenView& token : chunk.tokens) {
+            *out++ = encodeInstruction(token, pc, labels);
+            pc += 4;
+        }
+    });
+    return words;
+}
+
+string formatWordsParallel(const vector<uint32_t>& words, unsigned threads) {
+    // Fixed 33 bytes per word, so every slice knows where it writes
+    string text(words.size() * BITSTRING_LINE_BYTES, '\0');
+    size_t sliceCount = max<size_t>(1, min<size_t>(threads * CHUNKS_PER_THREAD,
+                                                   words.size() / 4096));
+    size_t sliceWords = words.size() / sliceCount + 1;
+
+    parallelFor(sliceCount, threads, [&](size_t slice) {
+        size_t begin = slice * sliceWords;
+        size_t end = min(words.size(), begin + sliceWords);
+        if (begin < end)
+            formatBitstrings(&words[begin], end - begin, &text[begin * BITSTRING_LINE_BYTES]);
+    });
+    return text;
+}
@@ -0,0 +1,79 @@
+/*------------------------------------------------------------------------------
+  File:        parallel_assembler.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the multi-threaded two-pass assembler used by -j.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               The source buffer is cut into chunks on line boundaries.
+               Each chunk is tokenized on its own thread with its own arena
+               and a label table relative to the chunk start. A prefix sum
+               over the per-chunk instruction counts gives every chunk its
+               base pc, the label tables are merged in source order (so the
+               last definition of a label still wins) and the chunks are
+               encoded, and for text output formatted, in parallel again.
+               The result is byte-identical to the serial path.
+
+  Dependencies:
+    - parser.h: TokenView, LabelTable, Arena
+    - <string>, <string_view>, <vector>, <memory>, <cstdint>
+  -----------------------------------------------------------------------------*/
+#ifndef PARALLEL_ASSEMBLER_H
+#define PARALLEL_ASSEMBLER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "parser.h"
+
+// One line-aligned slice of the source and what was parsed from it
+struct SourceChunk {
+    std::string_view text;
+    std::unique_ptr<Arena> arena;
+    // Labels with addresses relative to the start of this chunk
+    LabelTable labels;
+    std::vector<TokenView> tokens;
+    // Address of the chunk's first instruction
+    uint32_t basePc = 0;
+};
+
+/**
+ * Tokenizes the source on several threads and builds the global label table.
+ *
+ * @param source  - Complete assembly source; must outlive the chunks
+ * @param threads - Worker threads to use (at least 1)
+ * @param labels  - Filled with every label and its absolute address
+ * @return Parsed chunks in source order, with base pcs assigned
+ */
+std::vector<SourceChunk> parseParallel(std::string_view source, unsigned threads,
+                                       LabelTable& labels);
+
+/**
+ * Encodes parsed chunks on several threads.
+ *
+ * @param chunks  - Result of parseParallel
+ * @param labels  - Global label table from parseParallel
+ * @param threads - Worker threads to use (at least 1)
+ * @return Encoded words for the whole program
+ * @throws std::runtime_error for the first bad instruction in source order
+ */
+std::vector<uint32_t> encodeParallel(const std::vector<SourceChunk>& chunks,
+                                     const LabelTable& labels, unsigned threads);
+
+/**
+ * Formats words as the assembler's text output (one 32-character bitstring
+ * and '\n' per word) on several threads.
+ *
+ * @param words   - Encoded instructions
+ * @param threads - Worker threads to use (at least 1)
+ * @return The complete text file contents
+ */
+std::string formatWordsParallel(const std::vector<uint32_t>& words, unsigned threads);
+
+#endif // PARALLEL_ASSEMBLER_H
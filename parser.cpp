@@ -10,13 +10,14 @@
   Date:        July 2025
 
   Dependencies:
-    - parser.h
+    - parser.h, source_scanner.h
     - <sstream>, <algorithm>, <cstdint>
   -----------------------------------------------------------------------------*/
 #include "parser.h"
 #include <sstream>
 #include <algorithm>
 #include <cstdint>
+#include "source_scanner.h"
 
 using namespace std;
 
@@ -46,6 +47,293 @@ static vector<string> splitArguments(const string& str) {
     return args;
 }
 
+/**
+ * Parses one source line. Comments and whitespace are stripped, a leading
+ * "label:" is split off and the rest is tokenized.
+ */
+void parseLine(const string& rawLine, SourceLine& parsed) {
+    parsed.hasLabel = false;
+    parsed.hasInstruction = false;
+    parsed.label.clear();
+
+    // Remove comments - starting with #
+    // NOTE: Should we include // ???
+    string line = rawLine;
+    size_t commentPos = line.find('#');
+    if (commentPos != string::npos) {
+        line = line.substr(0, commentPos);
+    }
+    line = trim(line);
+
+    // Skip blank lines
+    if (line.empty())
+      return;
+
+    // Label check
+    size_t colonPos = line.find(':');
+    if (colonPos != string::npos) {
+        parsed.hasLabel = true;
+        parsed.label = trim(line.substr(0, colonPos));
+        // Rest of the line after the label (may be empty)
+        line = trim(line.substr(colonPos + 1));
+    }
+
+    if (line.empty()) 
+      return;
+
+    // Extract operation - the first word
+    stringstream ss(line);
+    parsed.token.op.clear();
+    ss >> parsed.token.op;
+
+    // Extract remaining string as arguments
+    string argString;
+    getline(ss, argString);
+    parsed.token.args = splitArguments(argString);
+    parsed.hasInstruction = true;
+}
+
+// Same whitespace set as trim(), without copying
+static string_view trimView(string_view s) {
+    const char* whitespace = " \t\n\r";
+    size_t start = s.find_first_not_of(whitespace);
+    if (start == string_view::npos) return string_view();
+    size_t end = s.find_last_not_of(whitespace);
+    return s.substr(start, end - start + 1);
+}
+
+// isspace() in the "C" locale the assembler always runs in, without the call
+static inline bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/**
+ * Calls visit on every operand of an instruction. Operands are the runs of
+ * non-whitespace characters inside the comma-separated fields, exactly what
+ * splitArguments produces.
+ *
+ * @param text       - Base the offsets are relative to
+ * @param start      - First byte after the operation
+ * @param end        - End of the instruction text
+ * @param commas     - Offsets of the commas between start and end, ascending
+ * @param commaCount - Number of entries in commas
+ */
+template <typename Visit>
+static void forEachOperand(const char* text, size_t start, size_t end,
+                           const uint32_t* commas, size_t commaCount, Visit visit) {
+    for (size_t field = 0; ; ++field) {
+        size_t fieldEnd = (field < commaCount) ? commas[field] : end;
+        size_t i = start;
+        while (i < fieldEnd) {
+            if (isSpace(text[i])) { ++i; continue; }
+            size_t wordStart = i;
+            while (i < fieldEnd && !isSpace(text[i]))
+                ++i;
+            visit(string_view(text + wordStart, i - wordStart));
+        }
+        if (field == commaCount)
+            break;
+        start = fieldEnd + 1;
+    }
+}
+
+/**
+ * View version of parseLine. The scanner has already found the line's
+ * comment, first colon and commas, so only the operation and the operand
+ * fields are still read byte by byte. Operand views go in the arena.
+ *
+ * @param text       - Base the offsets are relative to
+ * @param start      - Offset of the line
+ * @param end        - Offset of the comment or the end of the line
+ * @param colon      - Offset of the first ':' before end, or npos
+ * @param commas     - Offsets of the commas before end, ascending
+ * @param commaCount - Number of entries in commas
+ */
+static bool parseLineView(const char* text, size_t start, size_t end, size_t colon,
+                          const uint32_t* commas, size_t commaCount, Arena& arena,
+                          bool& hasLabel, string_view& label, TokenView& token) {
+    hasLabel = false;
+
+    // Label check
+    if (colon != string_view::npos) {
+        hasLabel = true;
+        label = trimView(string_view(text + start, colon - start));
+        start = colon + 1;
+    }
+    string_view line = trimView(string_view(text + start, end - start));
+    if (line.empty())
+        return false;
+
+    // Operation - the first whitespace-delimited word
+    size_t pos = 0;
+    while (pos < line.size() && isSpace(line[pos]))
+        ++pos;
+    size_t opStart = pos;
+    while (pos < line.size() && !isSpace(line[pos]))
+        ++pos;
+    token.op = line.substr(opStart, pos - opStart);
+
+    // Commas in the label or glued to the operation are not separators
+    size_t operandStart = static_cast<size_t>(line.data() - text) + pos;
+    size_t operandEnd = static_cast<size_t>(line.data() - text) + line.size();
+    while (commaCount > 0 && commas[0] < operandStart) {
+        ++commas;
+        --commaCount;
+    }
+
+    // Count the operands, then slice them into an exactly sized arena array
+    size_t argCount = 0;
+    forEachOperand(text, operandStart, operandEnd, commas, commaCount,
+                   [&](string_view) { ++argCount; });
+    string_view* args = arena.allocateArray<string_view>(argCount);
+    size_t n = 0;
+    forEachOperand(text, operandStart, operandEnd, commas, commaCount,
+                   [&](string_view arg) { args[n++] = arg; });
+    token.args = args;
+    token.argCount = argCount;
+    return true;
+}
+
+// The source is scanned in windows of about this size, extended to the next
+// newline, so the offsets of one window fit a buffer that is reused
+static const size_t SCAN_WINDOW = 1 << 16;
+
+vector<TokenView> parseSource(string_view source, Arena& arena, LabelTable& labels) {
+    // The shortest useful instruction line is about 16 bytes, so the vector
+    // rarely grows; it still doubles if the lines are shorter
+    vector<TokenView> tokens;
+    tokens.reserve(source.size() / 16 + 1);
+
+    vector<uint32_t> marks;
+    uint32_t pc = 0;
+    bool hasLabel;
+    string_view label;
+    TokenView token{};
+    size_t windowStart = 0;
+    while (windowStart < source.size()) {
+        size_t windowEnd = min(source.size(), windowStart + SCAN_WINDOW);
+        if (windowEnd < source.size()) {
+            size_t newline = source.find('\n', windowEnd);
+            windowEnd = (newline == string_view::npos) ? source.size() : newline + 1;
+        }
+        const char* text = source.data() + windowStart;
+        size_t length = windowEnd - windowStart;
+        windowStart = windowEnd;
+
+        if (marks.size() < length)
+            marks.resize(length);
+        size_t markCount = scanStructure(text, length, marks.data());
+
+        size_t lineStart = 0;
+        size_t m = 0;
+        while (lineStart < length) {
+            // Walk this line's marks. Commas are compacted in place at the
+            // front of them, since every mark is read before it is overwritten.
+            size_t lineEnd = length;
+            size_t comment = string_view::npos;
+            size_t colon = string_view::npos;
+            size_t commaStart = m;
+            size_t commaEnd = m;
+            for (; m < markCount; ++m) {
+                uint32_t offset = marks[m];
+                char c = text[offset];
+                if (c == '\n') {
+                    lineEnd = offset;
+                    ++m;
+                    break;
+                }
+                if (comment != string_view::npos)
+                    continue;
+                if (c == '#')
+                    comment = offset;
+                else if (c == ',')
+                    marks[commaEnd++] = offset;
+                else if (colon == string_view::npos)
+                    colon = offset;
+            }
+
+            size_t contentEnd = (comment != string_view::npos) ? comment : lineEnd;
+            bool hasInstruction = parseLineView(text, lineStart, contentEnd, colon,
+                                                marks.data() + commaStart, commaEnd - commaStart,
+                                                arena, hasLabel, label, token);
+            lineStart = lineEnd + 1;
+            if (hasLabel)
+                labels.set(label, pc);
+            if (!hasInstruction)
+                continue;
+
+            tokens.push_back(token);
+            pc += 4;
+        }
+    }
+    return tokens;
+}
+
+LabelTable::LabelTable() : slots(64), count(0) { }
+
+// FNV-1a over the name; the table size is a power of two
+static size_t hashLabel(string_view name) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+// Slot holding name, or the empty slot where it would go
+size_t LabelTable::slotFor(string_view name) const {
+    size_t mask = slots.size() - 1;
+    size_t index = hashLabel(name) & mask;
+    while (slots[index].used && slots[index].name != name)
+        index = (index + 1) & mask;
+    return index;
+}
+
+void LabelTable::grow() {
+    vector<Slot> old(slots.size() * 2);
+    old.swap(slots);
+    for (const Slot& slot : old) {
+        if (slot.used)
+            slots[slotFor(slot.name)] = slot;
+    }
+}
+
+void LabelTable::set(string_view name, uint32_t address) {
+    // Keep the load factor at or below one half
+    if ((count + 1) * 2 > slots.size())
+        grow();
+    Slot& slot = slots[slotFor(name)];
+    if (!slot.used) {
+        slot.used = true;
+        slot.name = name;
+        ++count;
+    }
+    slot.address = address;
+}
+
+const uint32_t* LabelTable::find(string_view name) const {
+    const Slot& slot = slots[slotFor(name)];
+    return slot.used ? &slot.address : nullptr;
+}
+
+void LabelTable::mergeFrom(const LabelTable& other, uint32_t offset) {
+    for (const Slot& slot : other.slots) {
+        if (slot.used)
+            set(slot.name, slot.address + offset);
+    }
+}
+
+unordered_map<string, uint32_t> LabelTable::toMap() const {
+    unordered_map<string, uint32_t> map;
+    map.reserve(count);
+    for (const Slot& slot : slots) {
+        if (slot.used)
+            map.emplace(string(slot.name), slot.address);
+    }
+    return map;
+}
+
 /**
  * Main parsing function. Reads cleaned assembly lines and returns Token objects.
  * Also builds the symbol table in a first pass.
@@ -55,53 +343,20 @@ vector<Token> parse(const vector<string>& lines,
     vector<Token> tokens;
     // Program counter starts at 0, incremented by 4 per instruction
     uint32_t pc = 0;  
+    SourceLine parsed;
 
     for (const string& rawLine : lines) {
-        // Remove comments - starting with #
-        // NOTE: Should we include // ???
-        string line = rawLine;
-        size_t commentPos = line.find('#');
-        if (commentPos != string::npos) {
-            line = line.substr(0, commentPos);
-        }
-        line = trim(line);
-      
-        // Skip blank lines
-        if (line.empty())
-          continue;
-
-        // Label check in loop
-        size_t colonPos = line.find(':');
-        if (colonPos != string::npos) {
-            string label = trim(line.substr(0, colonPos));
-            
-            // Map label to current instruction address
-            symTable[label] = pc;  
-
-            // Check for an instruction after the label
-            if (colonPos + 1 < line.length()) {
-                line = trim(line.substr(colonPos + 1));
-            } else {
-                // No instruction here
-                continue;  
-            }
-        }
-
-        if (line.empty()) 
-          continue;
+        parseLine(rawLine, parsed);
 
-        // Extract operation - the first word
-        stringstream ss(line);
-        string op;
-        ss >> op;
+        // Map label to current instruction address
+        if (parsed.hasLabel)
+            symTable[parsed.label] = pc;
 
-        // Extract remaining string as arguments
-        string argString;
-        getline(ss, argString);
-        vector<string> args = splitArguments(argString);
+        if (!parsed.hasInstruction)
+            continue;
 
         // Add token to the list
-        tokens.push_back({op, args});
+        tokens.push_back(parsed.token);
         // Advance the instruction by 4 bytes
         pc += 4;  
     }
@@ -10,16 +10,19 @@
   Date:        July 2025
 
   Dependencies:
-    - <string>, <vector>, <unordered_map>, <cstdint>
+    - arena.h
+    - <string>, <string_view>, <vector>, <unordered_map>, <cstdint>
   -----------------------------------------------------------------------------*/
 #ifndef PARSER_H
 #define PARSER_H
 
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map> 
 #include <cstdint> 
+#include "arena.h"
 
 // Represents a parsed instruction with its operation and operands
 struct Token {
@@ -29,6 +32,78 @@ struct Token {
     std::vector<std::string> args;  
 };
 
+// One source line split into its optional label and instruction
+struct SourceLine {
+    // True when the line has a "label:" (the label may be empty)
+    bool hasLabel = false;
+    std::string label;
+    // True when an instruction follows the label (or fills the line)
+    bool hasInstruction = false;
+    Token token;
+};
+
+/**
+ * Parses a single MIPS assembly line without touching any symbol table.
+ *
+ * @param rawLine - Source line, possibly with a comment or label
+ * @param parsed  - Receives the label and instruction found on the line
+ */
+void parseLine(const std::string& rawLine, SourceLine& parsed);
+
+// Token that points into the source buffer instead of owning strings
+struct TokenView {
+    std::string_view op;
+    // Operands, stored in the Arena passed to parseSource
+    const std::string_view* args;
+    size_t argCount;
+};
+
+/**
+ * Label to address table keyed by views into the source buffer. Open
+ * addressing in one array, so defining a label allocates nothing except
+ * when the table doubles.
+ */
+class LabelTable {
+public:
+    LabelTable();
+
+    // Defines or redefines a label (the last definition wins, like parse)
+    void set(std::string_view name, uint32_t address);
+    // Address of a label, or nullptr if it is not defined
+    const uint32_t* find(std::string_view name) const;
+    size_t size() const { return count; }
+    // Owning copy for the object file writer
+    std::unordered_map<std::string, uint32_t> toMap() const;
+    // Sets every label of other, shifted by offset (used to combine the
+    // tables of consecutive source chunks in order)
+    void mergeFrom(const LabelTable& other, uint32_t offset);
+
+private:
+    struct Slot {
+        std::string_view name;
+        uint32_t address;
+        bool used;
+    };
+
+    size_t slotFor(std::string_view name) const;
+    void grow();
+
+    std::vector<Slot> slots;
+    size_t count;
+};
+
+/**
+ * Parses a whole source buffer into view tokens without copying any text.
+ * Same rules as parseLine, applied to every line of the buffer. Line ends,
+ * comments, labels and operand fields come from scanStructure.
+ *
+ * @param source - Complete assembly source; must outlive the results
+ * @param arena  - Holds the operand arrays of the returned tokens
+ * @param labels - Filled with every label and its address
+ * @return One TokenView per instruction
+ */
+std::vector<TokenView> parseSource(std::string_view source, Arena& arena, LabelTable& labels);
+
 /**
  * Parses a list of MIPS assembly lines into Token objects.
  * Also builds a symbol table mapping labels to instruction addresses.
@@ -0,0 +1,162 @@
+/*------------------------------------------------------------------------------
+  File:        pipeline_model.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements the five-stage pipeline timing model.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - pipeline_model.h
+    - <algorithm>, <iomanip>
+  -----------------------------------------------------------------------------*/
+#include "pipeline_model.h"
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+// Instruction fields the model needs
+static const uint32_t OPCODE_RTYPE = 0x00;
+static const uint32_t OPCODE_J = 0x02;
+static const uint32_t OPCODE_BEQ = 0x04;
+static const uint32_t OPCODE_ADDI = 0x08;
+static const uint32_t OPCODE_LW = 0x23;
+static const uint32_t OPCODE_SW = 0x2B;
+
+// EX of the first instruction (IF in cycle 1, ID in cycle 2)
+static const uint64_t FIRST_EXECUTE = 3;
+
+PipelineModel::PipelineModel(const PipelineConfig& config)
+    : settings(config), lastExecute(FIRST_EXECUTE - 1), redirectExecute(0),
+      redirect(Redirect::None), writerExecute{}, writerIsLoad{} { }
+
+void PipelineModel::retire(const RetireRecord& record, unsigned fetchStall, unsigned memoryStall,
+                           PredictionOutcome prediction) {
+    uint32_t opcode = record.instruction >> 26;
+    uint32_t rs = (record.instruction >> 21) & 0x1F;
+    uint32_t rt = (record.instruction >> 16) & 0x1F;
+
+    // Registers read in EX, and the sw data register read in MEM
+    uint32_t sources[2];
+    size_t sourceCount = 0;
+    uint32_t storeData = 0;
+    switch (opcode) {
+        case OPCODE_RTYPE:
+        case OPCODE_BEQ:
+            sources[sourceCount++] = rs;
+            sources[sourceCount++] = rt;
+            break;
+        case OPCODE_ADDI:
+        case OPCODE_LW:
+            sources[sourceCount++] = rs;
+            break;
+        case OPCODE_SW:
+            sources[sourceCount++] = rs;
+            storeData = rt;
+            break;
+        default:
+            break;
+    }
+
+    // In order, behind any flush from the previous control transfer
+    uint64_t issue = lastExecute + 1;
+    uint64_t execute = issue;
+    if (redirect != Redirect::None && redirectExecute > execute) {
+        uint64_t flushed = redirectExecute - execute;
+        if (redirect == Redirect::Branch)
+            counters.branchFlushCycles += flushed;
+        else
+            counters.jumpFlushCycles += flushed;
+        execute = redirectExecute;
+    }
+    redirect = Redirect::None;
+    // A slow fetch delays everything after IF
+    execute += fetchStall;
+    counters.instructionCacheStalls += fetchStall;
+
+    // Latest operand requirement and whether a load imposed it
+    uint64_t ready = execute;
+    bool loadBound = false;
+    auto require = [&](uint32_t reg, bool inMemory) {
+        uint64_t writer = writerExecute[reg];
+        // Without a bypass the reader's EX follows the writer's WB by one cycle
+        if (reg == 0 || writer == 0 || execute >= writer + 3)
+            return;
+        ++counters.dataHazards;
+        uint64_t needed;
+        if (settings.forwarding) {
+            // ALU results leave EX one cycle later, loaded words leave MEM
+            needed = writer + (writerIsLoad[reg] ? 2 : 1);
+            // The sw data word is only used in MEM
+            if (inMemory)
+                --needed;
+            ++counters.forwardedOperands;
+        } else {
+            needed = writer + 3;
+        }
+        if (needed > ready) {
+            ready = needed;
+            loadBound = settings.forwarding && writerIsLoad[reg];
+        }
+    };
+    for (size_t i = 0; i < sourceCount; ++i)
+        require(sources[i], false);
+    if (opcode == OPCODE_SW)
+        require(storeData, true);
+
+    if (ready > execute) {
+        if (loadBound)
+            counters.loadUseStalls += ready - execute;
+        else
+            counters.rawStalls += ready - execute;
+        execute = ready;
+    }
+
+    // A slow MEM stage holds this instruction and everything behind it, as
+    // if its EX had come memoryStall cycles later
+    counters.dataCacheStalls += memoryStall;
+    uint64_t completed = execute + memoryStall;
+
+    if (record.destReg != RETIRE_NO_DEST && record.destReg != 0) {
+        writerExecute[record.destReg] = completed;
+        writerIsLoad[record.destReg] = (record.flags & RETIRE_MEM_READ) != 0;
+    }
+    // Without a predictor fetch always continues at pc + 4
+    bool flush = (prediction == PredictionOutcome::NotControl)
+        ? (opcode == OPCODE_BEQ && (record.flags & RETIRE_BRANCH_TAKEN)) || opcode == OPCODE_J
+        : prediction == PredictionOutcome::Mispredicted;
+    if (flush && opcode == OPCODE_BEQ) {
+        ++counters.branchFlushes;
+        redirect = Redirect::Branch;
+        redirectExecute = execute + 1 + settings.branchPenalty;
+    } else if (flush && opcode == OPCODE_J) {
+        ++counters.jumpFlushes;
+        redirect = Redirect::Jump;
+        redirectExecute = execute + 1 + settings.jumpPenalty;
+    }
+
+    lastExecute = completed;
+    ++counters.instructions;
+    // MEM and WB follow EX
+    counters.cycles = completed + 2;
+}
+
+void PipelineModel::report(ostream& out) const {
+    const PipelineStats& s = counters;
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << "Pipeline: 5-stage, forwarding " << (settings.forwarding ? "on" : "off")
+        << ", beq penalty " << settings.branchPenalty << ", j penalty " << settings.jumpPenalty << '\n';
+    out << "  Cycles: " << s.cycles << ", instructions: " << s.instructions
+        << ", CPI: " << fixed << setprecision(3) << s.cpi() << '\n';
+    out.flags(flags);
+    out.precision(precision);
+    out << "  Data hazards: " << s.dataHazards << " (" << s.forwardedOperands << " forwarded)\n";
+    out << "  Stall cycles: load-use " << s.loadUseStalls << ", RAW " << s.rawStalls
+        << ", beq flush " << s.branchFlushCycles << " (" << s.branchFlushes << " beq)"
+        << ", j flush " << s.jumpFlushCycles << " (" << s.jumpFlushes << " j)"
+        << ", I-cache " << s.instructionCacheStalls << ", D-cache " << s.dataCacheStalls << '\n';
+}
@@ -0,0 +1,123 @@
+/*------------------------------------------------------------------------------
+  File:        pipeline_model.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the five-stage (IF/ID/EX/MEM/WB) pipeline timing
+               model that estimates cycle counts for a functional run.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               The model is trace driven: the CPU runs the program as usual
+               and hands over a RetireRecord per instruction in program
+               order. For each one the model works out the cycle its EX
+               stage can start, from three constraints:
+
+               - In-order issue: one cycle after the previous instruction.
+               - Control: after a taken beq the instructions fetched behind
+                 it are flushed (branchPenalty cycles, beq resolves in EX);
+                 after a j, jumpPenalty cycles (the target is known in ID).
+                 With a branch predictor attached only mispredicted beq
+                 and j instructions flush.
+               - Data: every source register must be ready. With forwarding
+                 an ALU result reaches the next EX directly, a loaded value
+                 one cycle later (the load-use stall), and the data word of
+                 a sw is only needed in MEM. Without forwarding a reader's
+                 ID must wait for the writer's WB (the register file is
+                 written in the first half of the cycle, read in the second).
+
+               The first instruction is fetched in cycle 1, so its EX is
+               cycle 3 and a program of n independent instructions takes
+               n + 4 cycles.
+
+               When cache models are attached, an instruction cache miss
+               holds up the fetch and a data cache miss holds the whole
+               pipeline in MEM, each for the cache's miss penalty.
+
+  Dependencies:
+    - retire_trace.h, branch_predictor.h
+    - <cstdint>, <array>, <ostream>
+  -----------------------------------------------------------------------------*/
+#ifndef PIPELINE_MODEL_H
+#define PIPELINE_MODEL_H
+
+#include <cstdint>
+#include <array>
+#include <ostream>
+#include "retire_trace.h"
+#include "branch_predictor.h"
+
+struct PipelineConfig {
+    // Bypass EX/MEM and MEM/WB results to the ALU inputs and to MEM
+    bool forwarding = true;
+    // Cycles lost after a taken beq
+    unsigned branchPenalty = 2;
+    // Cycles lost after a j
+    unsigned jumpPenalty = 1;
+};
+
+struct PipelineStats {
+    uint64_t instructions = 0;
+    // Cycles until the last instruction leaves WB
+    uint64_t cycles = 0;
+    // Source operands written by an instruction still in the pipeline
+    uint64_t dataHazards = 0;
+    // Hazards satisfied through a bypass (forwarding only)
+    uint64_t forwardedOperands = 0;
+    // Stall cycles by cause
+    uint64_t loadUseStalls = 0;
+    uint64_t rawStalls = 0;
+    uint64_t branchFlushCycles = 0;
+    uint64_t jumpFlushCycles = 0;
+    uint64_t instructionCacheStalls = 0;
+    uint64_t dataCacheStalls = 0;
+    // Control transfers that caused a flush
+    uint64_t branchFlushes = 0;
+    uint64_t jumpFlushes = 0;
+
+    double cpi() const { return instructions ? double(cycles) / double(instructions) : 0.0; }
+};
+
+class PipelineModel {
+public:
+    explicit PipelineModel(const PipelineConfig& config = PipelineConfig());
+
+    /**
+     * Accounts for the next instruction in program order.
+     *
+     * @param record      - The instruction as retired by the CPU
+     * @param fetchStall  - Extra cycles its fetch took (instruction cache miss)
+     * @param memoryStall - Extra cycles its MEM stage took (data cache miss)
+     * @param prediction  - What a branch predictor made of it; NotControl
+     *                      when none is attached, in which case every taken
+     *                      beq and every j flushes
+     */
+    void retire(const RetireRecord& record, unsigned fetchStall = 0, unsigned memoryStall = 0,
+                PredictionOutcome prediction = PredictionOutcome::NotControl);
+
+    const PipelineConfig& config() const { return settings; }
+    const PipelineStats& stats() const { return counters; }
+
+    // Prints cycles, CPI, hazards and the stall breakdown
+    void report(std::ostream& out) const;
+
+private:
+    // Why the next instruction may have to wait before its EX stage
+    enum class Redirect : uint8_t { None, Branch, Jump };
+
+    PipelineConfig settings;
+    PipelineStats counters;
+    // EX cycle of the last instruction accounted for
+    uint64_t lastExecute;
+    // Earliest EX cycle after the last control transfer, and its cause
+    uint64_t redirectExecute;
+    Redirect redirect;
+    // EX cycle of the last in-flight writer of each register (0 = none)
+    std::array<uint64_t, 32> writerExecute;
+    // Whether that writer was a lw
+    std::array<bool, 32> writerIsLoad;
+};
+
+#endif // PIPELINE_MODEL_H
@@ -0,0 +1,172 @@
+/*------------------------------------------------------------------------------
+  File:        profiler.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements the per-pc counters, the loop detection and the
+               profile report.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - profiler.h, disassembler.h
+    - <algorithm>, <iomanip>, <sstream>, <string>
+  -----------------------------------------------------------------------------*/
+#include "profiler.h"
+#include "disassembler.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+static const uint32_t OPCODE_J = 0x02;
+static const uint32_t OPCODE_BEQ = 0x04;
+
+Profiler::Profiler()
+    : total(0), loads(0), stores(0), branchesTaken(0), branchesNotTaken(0), jumps(0),
+      classCounts{}, classSamples{} { }
+
+void Profiler::retire(const RetireRecord& record) {
+    size_t slot = record.pc >> 2;
+    if (slot >= pcCounts.size()) {
+        size_t size = max(slot + 1, pcCounts.size() * 2);
+        pcCounts.resize(size, 0);
+        takenCounts.resize(size, 0);
+        pcInstructions.resize(size, 0);
+    }
+    ++pcCounts[slot];
+    pcInstructions[slot] = record.instruction;
+    ++total;
+
+    uint32_t opcode = record.instruction >> 26;
+    size_t instructionClass = opcode == 0 ? 64 + (record.instruction & 0x3F) : opcode;
+    ++classCounts[instructionClass];
+    classSamples[instructionClass] = record.instruction;
+
+    if (record.flags & RETIRE_MEM_READ)
+        ++loads;
+    if (record.flags & RETIRE_MEM_WRITE)
+        ++stores;
+
+    uint32_t target;
+    if (opcode == OPCODE_BEQ) {
+        if (!(record.flags & RETIRE_BRANCH_TAKEN)) {
+            ++branchesNotTaken;
+            return;
+        }
+        ++branchesTaken;
+        ++takenCounts[slot];
+        int32_t offset = static_cast<int16_t>(record.instruction & 0xFFFF);
+        target = record.pc + 4 + (static_cast<uint32_t>(offset) << 2);
+    } else if (opcode == OPCODE_J) {
+        ++jumps;
+        target = (record.pc & 0xF0000000) | ((record.instruction & 0x03FFFFFF) << 2);
+    } else {
+        return;
+    }
+    if (target <= record.pc)
+        ++backEdges[(uint64_t(target) << 32) | record.pc];
+}
+
+void Profiler::report(ostream& out, size_t maxEntries) const {
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    auto percent = [this](uint64_t part) {
+        return total ? 100.0 * double(part) / double(total) : 0.0;
+    };
+    // Source text when the line table has the pc, the disassembly otherwise
+    auto sourceText = [this](uint32_t pc) {
+        const LineEntry* entry = lines.find(pc);
+        return entry ? entry->text : disassembleInstruction(pcInstructions[pc >> 2], pc);
+    };
+    auto lineNumber = [this](uint32_t pc) -> string {
+        const LineEntry* entry = lines.find(pc);
+        return entry ? "line " + to_string(entry->line) : "";
+    };
+    out << fixed << setprecision(1);
+
+    out << "Profile: " << total << " instruction(s) retired";
+    if (!lines.sourcePath.empty())
+        out << " from " << lines.sourcePath;
+    out << '\n';
+
+    // Instruction mix, most frequent first
+    vector<size_t> classes;
+    for (size_t i = 0; i < CLASS_COUNT; ++i) {
+        if (classCounts[i])
+            classes.push_back(i);
+    }
+    stable_sort(classes.begin(), classes.end(),
+                [this](size_t a, size_t b) { return classCounts[a] > classCounts[b]; });
+    out << "  Mix:";
+    for (size_t i = 0; i < classes.size(); ++i) {
+        string text = disassembleInstruction(classSamples[classes[i]], 0);
+        out << (i ? ", " : " ") << text.substr(0, text.find(' ')) << ' '
+            << classCounts[classes[i]] << " (" << percent(classCounts[classes[i]]) << "%)";
+    }
+    out << '\n';
+    out << "  Memory: " << loads << " load(s), " << stores << " store(s)\n";
+    out << "  Branches: beq " << branchesTaken << " taken, " << branchesNotTaken
+        << " not taken; j " << jumps << '\n';
+
+    // Hottest instructions, listed in address order
+    vector<uint32_t> hot;
+    for (size_t slot = 0; slot < pcCounts.size(); ++slot) {
+        if (pcCounts[slot])
+            hot.push_back(static_cast<uint32_t>(slot << 2));
+    }
+    stable_sort(hot.begin(), hot.end(),
+                [this](uint32_t a, uint32_t b) { return pcCounts[a >> 2] > pcCounts[b >> 2]; });
+    if (hot.size() > maxEntries)
+        hot.resize(maxEntries);
+    sort(hot.begin(), hot.end());
+    out << "  Hot instructions:\n";
+    for (uint32_t pc : hot) {
+        uint64_t count = pcCounts[pc >> 2];
+        out << "    [" << hex << setw(8) << setfill('0') << pc << dec << setfill(' ') << "] "
+            << left << setw(14) << lines.describe(pc) << setw(10) << lineNumber(pc)
+            << setw(24) << sourceText(pc) << right << setw(12) << count
+            << " (" << setw(5) << percent(count) << "%)";
+        if ((pcInstructions[pc >> 2] >> 26) == OPCODE_BEQ)
+            out << ", taken " << takenCounts[pc >> 2];
+        out << '\n';
+    }
+
+    // Loops: every backward edge, weighted by the instructions in its body
+    struct Loop {
+        uint32_t head;
+        uint32_t tail;
+        uint64_t iterations;
+        uint64_t body;
+    };
+    vector<Loop> loops;
+    for (const auto& edge : backEdges) {
+        Loop loop{static_cast<uint32_t>(edge.first >> 32), static_cast<uint32_t>(edge.first),
+                  edge.second, 0};
+        for (uint64_t slot = loop.head >> 2; slot <= loop.tail >> 2; ++slot)
+            loop.body += pcCounts[slot];
+        loops.push_back(loop);
+    }
+    sort(loops.begin(), loops.end(), [](const Loop& a, const Loop& b) {
+        if (a.body != b.body)
+            return a.body > b.body;
+        return a.head != b.head ? a.head < b.head : a.tail < b.tail;
+    });
+    if (loops.size() > maxEntries)
+        loops.resize(maxEntries);
+    out << "  Hot loops:" << (loops.empty() ? " none\n" : "\n");
+    for (const Loop& loop : loops) {
+        out << "    " << lines.describe(loop.head) << " .. " << lines.describe(loop.tail);
+        const LineEntry* first = lines.find(loop.head);
+        const LineEntry* last = lines.find(loop.tail);
+        if (first && last)
+            out << " (lines " << first->line << '-' << last->line << ')';
+        out << ": " << loop.iterations << " iteration(s), " << loop.body
+            << " instruction(s) (" << percent(loop.body) << "%)\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,87 @@
+/*------------------------------------------------------------------------------
+  File:        profiler.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the guest-level profiler: where a simulated program
+               spends its instructions.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Counts every retired instruction per pc and per instruction
+               class (opcode, or funct for R-type), loads and stores, and
+               taken and untaken beq. A taken beq or a j to an address at
+               or before its own pc is a backward edge; each distinct edge
+               is reported as a loop from the target (head) to the branch
+               (tail), with its iteration count and the instructions
+               retired between head and tail.
+
+               The report maps pcs to source lines and labels through a
+               LineTable (see line_table.h) when one is given, and falls
+               back to the disassembly otherwise.
+
+  Dependencies:
+    - retire_trace.h, line_table.h
+    - <cstdint>, <vector>, <array>, <unordered_map>, <ostream>
+  -----------------------------------------------------------------------------*/
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <ostream>
+#include "retire_trace.h"
+#include "line_table.h"
+
+class Profiler {
+public:
+    Profiler();
+
+    // Accounts for the next retired instruction
+    void retire(const RetireRecord& record);
+
+    // Source lines and labels used by report()
+    void setLineTable(const LineTable& table) { lines = table; }
+
+    uint64_t instructions() const { return total; }
+    // Times the instruction at pc retired
+    uint64_t executions(uint32_t pc) const {
+        return (pc >> 2) < pcCounts.size() ? pcCounts[pc >> 2] : 0;
+    }
+
+    /**
+     * Prints the instruction mix, memory and branch counts, the hottest
+     * instructions and the hottest loops.
+     *
+     * @param out        - Report destination
+     * @param maxEntries - Instructions and loops listed at most
+     */
+    void report(std::ostream& out, size_t maxEntries = 20) const;
+
+private:
+    // Opcodes 0-63, then R-type functs at 64 + funct
+    static const size_t CLASS_COUNT = 128;
+
+    uint64_t total;
+    uint64_t loads;
+    uint64_t stores;
+    uint64_t branchesTaken;
+    uint64_t branchesNotTaken;
+    uint64_t jumps;
+    // Indexed by pc / 4
+    std::vector<uint64_t> pcCounts;
+    std::vector<uint64_t> takenCounts;
+    std::vector<uint32_t> pcInstructions;
+    std::array<uint64_t, CLASS_COUNT> classCounts;
+    // One instruction of each class, to name it
+    std::array<uint32_t, CLASS_COUNT> classSamples;
+    // Backward edges keyed by head << 32 | tail
+    std::unordered_map<uint64_t, uint64_t> backEdges;
+    LineTable lines;
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,46 @@
+/*------------------------------------------------------------------------------
+  File:        program_loader.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements the program and memory image readers.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - program_loader.h, object_file.h, bitstring_codec.h, source_scanner.h
+    - <fstream>, <iterator>, <stdexcept>
+  -----------------------------------------------------------------------------*/
+#include "program_loader.h"
+#include "object_file.h"
+#include "bitstring_codec.h"
+#include "source_scanner.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+using namespace std;
+
+vector<uint32_t> readProgramFile(const string& path) {
+    if (isObjectFile(path)) {
+        ObjectFile object(path);
+        return vector<uint32_t>(object.text(), object.text() + object.textCount());
+    }
+
+    // Decoded straight from the mapping, with no copy of the text
+    MappedSource text(path);
+    return parseBitstrings(text.view(), path);
+}
+
+vector<uint8_t> readMemoryImage(const string& path) {
+    ifstream in(path, ios::binary);
+    if (!in) {
+        throw runtime_error("Cannot open memory image " + path);
+    }
+    vector<uint8_t> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (in.bad()) {
+        throw runtime_error("Failed reading memory image " + path);
+    }
+    return bytes;
+}
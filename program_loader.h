@@ -0,0 +1,44 @@
+/*------------------------------------------------------------------------------
+  File:        program_loader.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the file readers shared by the simulator drivers:
+               programs (bitstring text or object files) and raw memory
+               images.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - <string>, <vector>, <cstdint>
+  -----------------------------------------------------------------------------*/
+#ifndef PROGRAM_LOADER_H
+#define PROGRAM_LOADER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * Reads a program written by the assembler. Object files are detected by
+ * their magic; anything else is read as text, one 32-character bitstring
+ * per line (blank lines and '#' comments are skipped).
+ *
+ * @param path - Program file path
+ * @return Instruction words in program order
+ * @throws std::runtime_error if the file cannot be opened, the object
+ *         file is malformed or a text line is not a bitstring
+ */
+std::vector<uint32_t> readProgramFile(const std::string& path);
+
+/**
+ * Reads a raw memory image, copied byte for byte to data address 0.
+ *
+ * @param path - Image file path
+ * @return File contents
+ * @throws std::runtime_error if the file cannot be read
+ */
+std::vector<uint8_t> readMemoryImage(const std::string& path);
+
+#endif // PROGRAM_LOADER_H
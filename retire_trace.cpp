@@ -0,0 +1,179 @@
+/*------------------------------------------------------------------------------
+  File:        retire_trace.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements reading, writing and formatting of binary retire
+               traces.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - retire_trace.h, disassembler.h
+    - <cstring>, <cstdio>, <cerrno>, <stdexcept>
+    - POSIX I/O (<fcntl.h>, <unistd.h>)
+  -----------------------------------------------------------------------------*/
+#include "retire_trace.h"
+#include "disassembler.h"
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const char RETIRE_TRACE_MAGIC[4] = {'T', 'M', 'R', 'T'};
+
+// Same values as the object file endianness flag
+static uint8_t hostEndianness() {
+    const uint16_t probe = 1;
+    uint8_t firstByte;
+    memcpy(&firstByte, &probe, 1);
+    return firstByte == 1 ? 0 : 1;
+}
+
+// Writes every byte, retrying short writes and interrupts
+static bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t count = ::write(fd, bytes, size);
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        bytes += count;
+        size -= static_cast<size_t>(count);
+    }
+    return true;
+}
+
+// Reads until size bytes arrive or the file ends; returns bytes read or -1
+static ssize_t readAll(int fd, void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    size_t total = 0;
+    while (total < size) {
+        ssize_t count = ::read(fd, bytes + total, size - total);
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (count == 0)
+            break;
+        total += static_cast<size_t>(count);
+    }
+    return static_cast<ssize_t>(total);
+}
+
+// Example: [0000000c] sw $t2, 0($zero)        M[0] = 10
+string formatRetireRecord(const RetireRecord& record) {
+    char pcText[16];
+    snprintf(pcText, sizeof(pcText), "[%08x] ", record.pc);
+    string text = disassembleInstruction(record.instruction, record.pc);
+    string line = pcText + text;
+
+    // Pad so the changed state lines up in a column
+    bool isBeq = (record.instruction >> 26) == 0x04;
+    bool memWrite = (record.flags & RETIRE_MEM_WRITE) != 0;
+    bool hasChange = memWrite || record.destReg != RETIRE_NO_DEST || isBeq;
+    if (hasChange && text.size() < 28)
+        line.append(28 - text.size(), ' ');
+
+    if (memWrite)
+        line += "M[" + to_string(record.memAddress) + "] = " + to_string(record.memValue);
+    else if (record.destReg != RETIRE_NO_DEST)
+        line += namedRegister(record.destReg) + " = " + to_string(record.destValue);
+    else if (isBeq)
+        line += (record.flags & RETIRE_BRANCH_TAKEN) ? "taken" : "not taken";
+    return line;
+}
+
+RetireTraceWriter::RetireTraceWriter(const string& path, size_t bufferRecords)
+    : fd(-1), path(path), buffer(bufferRecords > 0 ? bufferRecords : 1), used(0), written(0) {
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw runtime_error("Cannot open trace file " + path);
+    }
+
+    RetireTraceHeader header{};
+    memcpy(header.magic, RETIRE_TRACE_MAGIC, sizeof(RETIRE_TRACE_MAGIC));
+    header.version = RETIRE_TRACE_VERSION;
+    header.recordSize = sizeof(RetireRecord);
+    header.endianness = hostEndianness();
+    if (!writeAll(fd, &header, sizeof(header))) {
+        close(fd);
+        throw runtime_error("Cannot write trace file " + path);
+    }
+}
+
+RetireTraceWriter::~RetireTraceWriter() {
+    // Errors can't be reported from here; callers that care call flush()
+    try {
+        drain();
+    } catch (const exception&) {
+    }
+    close(fd);
+}
+
+void RetireTraceWriter::drain() {
+    if (used == 0)
+        return;
+    size_t bytes = used * sizeof(RetireRecord);
+    written += used;
+    used = 0;
+    if (!writeAll(fd, buffer.data(), bytes)) {
+        throw runtime_error("Cannot write trace file " + path);
+    }
+}
+
+RetireTraceReader::RetireTraceReader(const string& path, size_t bufferRecords)
+    : fd(-1), path(path), buffer(bufferRecords > 0 ? bufferRecords : 1), available(0), position(0) {
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Cannot open trace file " + path);
+    }
+
+    RetireTraceHeader header{};
+    if (readAll(fd, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))
+            || memcmp(header.magic, RETIRE_TRACE_MAGIC, sizeof(RETIRE_TRACE_MAGIC)) != 0) {
+        close(fd);
+        throw runtime_error("Not a Tiny MIPS retire trace: " + path);
+    }
+    if (header.endianness != hostEndianness()) {
+        close(fd);
+        throw runtime_error("Trace was written on a host of the other endianness: " + path);
+    }
+    if (header.version != RETIRE_TRACE_VERSION || header.recordSize != sizeof(RetireRecord)) {
+        close(fd);
+        throw runtime_error("Unsupported retire trace version: " + path);
+    }
+}
+
+RetireTraceReader::~RetireTraceReader() {
+    close(fd);
+}
+
+bool RetireTraceReader::next(RetireRecord& record) {
+    if (position == available && !refill())
+        return false;
+    record = buffer[position++];
+    return true;
+}
+
+bool RetireTraceReader::refill() {
+    ssize_t bytes = readAll(fd, buffer.data(), buffer.size() * sizeof(RetireRecord));
+    if (bytes < 0) {
+        throw runtime_error("Cannot read trace file " + path);
+    }
+    if (bytes % sizeof(RetireRecord) != 0) {
+        throw runtime_error("Truncated record in trace file " + path);
+    }
+    available = static_cast<size_t>(bytes) / sizeof(RetireRecord);
+    position = 0;
+    return available > 0;
+}
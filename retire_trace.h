@@ -0,0 +1,150 @@
+/*------------------------------------------------------------------------------
+  File:        retire_trace.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the compact binary retire trace written by the CPU
+               simulator and read back by the tiny_mips_trace decoder.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               A trace file is a 16-byte header followed by one 24-byte
+               RetireRecord per retired instruction, in retire order:
+
+               | 0-3   | magic "TMRT"                              |
+               | 4-5   | format version                            |
+               | 6-7   | record size in bytes (24)                 |
+               | 8     | endianness of every multi-byte field      |
+               | 9-15  | reserved (0)                              |
+
+               Records are written in host byte order through a large
+               buffer, so capturing a trace costs one 24-byte copy per
+               instruction instead of formatting text.
+
+  Dependencies:
+    - <string>, <vector>, <cstdint>, <cstddef>
+  -----------------------------------------------------------------------------*/
+#ifndef RETIRE_TRACE_H
+#define RETIRE_TRACE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Current retire trace format version
+const uint16_t RETIRE_TRACE_VERSION = 1;
+
+// destReg value for instructions that write no register
+const uint8_t RETIRE_NO_DEST = 0xFF;
+
+// RetireRecord::flags bits
+const uint8_t RETIRE_MEM_READ = 0x01;
+const uint8_t RETIRE_MEM_WRITE = 0x02;
+const uint8_t RETIRE_BRANCH_TAKEN = 0x04;
+
+// One retired instruction (24 bytes, no padding)
+struct RetireRecord {
+    uint32_t pc;
+    uint32_t instruction;
+    // New value of destReg
+    uint32_t destValue;
+    // Effective address and word for lw/sw
+    uint32_t memAddress;
+    uint32_t memValue;
+    // Register written, or RETIRE_NO_DEST
+    uint8_t destReg;
+    uint8_t flags;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(RetireRecord) == 24, "RetireRecord must stay 24 bytes");
+
+// Fixed-size header at the start of every trace file
+struct RetireTraceHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t recordSize;
+    uint8_t endianness;
+    uint8_t reserved[7];
+};
+
+/**
+ * Formats a record the same way as the simulator's --trace=changed output.
+ *
+ * @param record - Record to format
+ * @return Line without the trailing newline, e.g.
+ *         "[0000000c] sw $t2, 0($zero)            M[0] = 10"
+ */
+std::string formatRetireRecord(const RetireRecord& record);
+
+/**
+ * Buffered writer for a trace file. The header is written on construction
+ * and records are written out whenever the buffer fills and on flush().
+ */
+class RetireTraceWriter {
+public:
+    // Creates or truncates the file; throws std::runtime_error
+    explicit RetireTraceWriter(const std::string& path, size_t bufferRecords = 1 << 14);
+    ~RetireTraceWriter();
+
+    RetireTraceWriter(const RetireTraceWriter&) = delete;
+    RetireTraceWriter& operator=(const RetireTraceWriter&) = delete;
+
+    // Queues one record (inline so the interpreter loops stay cheap)
+    void append(const RetireRecord& record) {
+        if (used == buffer.size())
+            drain();
+        buffer[used++] = record;
+    }
+
+    // Writes all queued records; throws std::runtime_error on write failure
+    void flush() { drain(); }
+    // Records appended since the file was opened
+    uint64_t recordCount() const { return written + used; }
+
+private:
+    void drain();
+
+    int fd;
+    std::string path;
+    std::vector<RetireRecord> buffer;
+    size_t used;
+    uint64_t written;
+};
+
+/**
+ * Sequential reader for a trace file, refilled in large chunks so traces
+ * of any size can be filtered without loading them whole.
+ */
+class RetireTraceReader {
+public:
+    // Opens the file and validates the header; throws std::runtime_error
+    explicit RetireTraceReader(const std::string& path, size_t bufferRecords = 1 << 14);
+    ~RetireTraceReader();
+
+    RetireTraceReader(const RetireTraceReader&) = delete;
+    RetireTraceReader& operator=(const RetireTraceReader&) = delete;
+
+    /**
+     * Reads the next record.
+     *
+     * @param record - Set to the next record on success
+     * @return false at the end of the trace
+     * @throws std::runtime_error on a read error or a truncated record
+     */
+    bool next(RetireRecord& record);
+
+private:
+    bool refill();
+
+    int fd;
+    std::string path;
+    std::vector<RetireRecord> buffer;
+    size_t available;
+    size_t position;
+};
+
+#endif // RETIRE_TRACE_H
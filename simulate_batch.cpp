@@ -0,0 +1,239 @@
+/*------------------------------------------------------------------------------
+  File:        simulate_batch.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Batch simulator driver. Runs many programs, or one program
+               against many initial memory images, on a pool of threads.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Every run gets its own TinyMipsCPU and trace sink, so runs
+               share nothing but the (read-only) program in image mode. Runs
+               are spread over the work-stealing pool from work_pool.cpp.
+               Once all have finished, one line per run is printed in input
+               order with its instruction count and final state hash, then
+               a summary with the aggregate instruction rate.
+
+               .s inputs are assembled in memory on the worker thread
+               (tiny_mips.h), so no assembler output files are needed.
+
+  Dependencies:
+    - tiny_mips.h, program_loader.h, trace_sink.h, work_pool.h
+    - <iostream>, <fstream>, <sstream>, <iomanip>, <string>, <vector>, <chrono>,
+      <thread>, <cstdlib>, <cerrno>, <cctype>, <stdexcept>
+  -----------------------------------------------------------------------------*/
+#include "tiny_mips.h"
+#include "program_loader.h"
+#include "trace_sink.h"
+#include "work_pool.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cerrno>
+#include <cctype>
+#include <stdexcept>
+
+using namespace std;
+
+// Command line settings shared by every run
+struct BatchOptions {
+    ExecEngine engine = ExecEngine::Threaded;
+    // 0 keeps the default limit of one pass over the program
+    uint64_t maxSteps = 0;
+    Endianness endianness = Endianness::Big;
+    unsigned threads = 0;
+    // Image mode: run this program once per memory image
+    string programPath;
+    // Programs, or memory images in image mode
+    vector<string> inputs;
+};
+
+// Final state of one run
+struct RunOutcome {
+    bool ok = false;
+    string error;
+    uint64_t steps = 0;
+    uint64_t stateHash = 0;
+    size_t residentPages = 0;
+    bool hitStepLimit = false;
+};
+
+static void printUsage() {
+    cerr << "Usage: ./simulate_batch [options] <program|source.s>...\n"
+         << "       ./simulate_batch [options] --program=FILE <memory_image>...\n"
+         << "  --engine=step|threaded|jit  Interpreter to use (default threaded)\n"
+         << "  --max-steps=N               Stop each run after N instructions\n"
+         << "                              (default program length)\n"
+         << "  --endian=big|little         Byte order of data memory words (default big)\n"
+         << "  --program=FILE              Run FILE once per raw memory image, each\n"
+         << "                              copied to data address 0\n"
+         << "  -j N                        Runs at once (default one per core)\n";
+}
+
+// Parses a decimal number with nothing after it. False if it is empty,
+// signed, followed by anything else or above limit.
+static bool parseCount(const char* text, uint64_t limit, uint64_t& value) {
+    if (!isdigit(static_cast<unsigned char>(text[0])))
+        return false;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed > limit)
+        return false;
+    value = parsed;
+    return true;
+}
+
+// Returns false on unknown options, bad values or when there is nothing to run
+static bool parseOptions(int argc, char* argv[], BatchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--engine=step") {
+            options.engine = ExecEngine::Step;
+        } else if (arg == "--engine=threaded") {
+            options.engine = ExecEngine::Threaded;
+        } else if (arg == "--engine=jit") {
+            options.engine = ExecEngine::Jit;
+        } else if (arg == "--endian=big") {
+            options.endianness = Endianness::Big;
+        } else if (arg == "--endian=little") {
+            options.endianness = Endianness::Little;
+        } else if (arg.rfind("--max-steps=", 0) == 0) {
+            // 0 would mean "use the default", so it is not a valid limit
+            if (!parseCount(arg.c_str() + 12, UINT64_MAX, options.maxSteps) || options.maxSteps == 0)
+                return false;
+        } else if (arg.rfind("--program=", 0) == 0) {
+            options.programPath = arg.substr(10);
+            if (options.programPath.empty())
+                return false;
+        } else if (arg.rfind("-j", 0) == 0) {
+            // Accepts "-j N" and "-jN"
+            string count = arg.substr(2);
+            if (count.empty() && i + 1 < argc)
+                count = argv[++i];
+            uint64_t threads = 0;
+            if (!parseCount(count.c_str(), 4096, threads) || threads == 0)
+                return false;
+            options.threads = static_cast<unsigned>(threads);
+        } else if (arg.rfind("-", 0) == 0) {
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    return !options.inputs.empty();
+}
+
+/*
+ * Reads a program file, or assembles a .s source in memory.
+ * Throws std::runtime_error if the file cannot be read or assembled.
+ */
+static vector<uint32_t> loadProgramWords(const string& path) {
+    if (path.size() < 2 || path.compare(path.size() - 2, 2, ".s") != 0)
+        return readProgramFile(path);
+    ifstream in(path, ios::binary);
+    if (!in) {
+        throw runtime_error("Cannot open file " + path);
+    }
+    ostringstream source;
+    source << in.rdbuf();
+    return assembleSource(source.str());
+}
+
+// Runs one loaded CPU to completion without any trace output
+static void runToCompletion(TinyMipsCPU& cpu, const BatchOptions& options, RunOutcome& outcome) {
+    // Private sink: nothing is written at TraceLevel::None, but the CPU
+    // flushes its sink before reporting errors
+    TraceSink sink(1, 256);
+    cpu.setTrace(TraceLevel::None, sink);
+    cpu.setEngine(options.engine);
+    if (options.maxSteps != 0)
+        cpu.setMaxSteps(options.maxSteps);
+    cpu.executeProgram();
+
+    outcome.ok = true;
+    outcome.steps = cpu.stepsExecuted();
+    outcome.stateHash = cpu.stateHash();
+    outcome.residentPages = cpu.residentPages();
+    outcome.hitStepLimit = cpu.hitStepLimit();
+}
+
+int main(int argc, char* argv[]) {
+    BatchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (options.threads == 0)
+        options.threads = max(1u, thread::hardware_concurrency());
+
+    // Image mode reads the program once; every run decodes its own copy
+    vector<uint32_t> sharedProgram;
+    bool imageMode = !options.programPath.empty();
+    if (imageMode) {
+        try {
+            sharedProgram = loadProgramWords(options.programPath);
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    vector<RunOutcome> outcomes(options.inputs.size());
+    auto start = chrono::steady_clock::now();
+    runWorkStealing(options.inputs.size(), options.threads, [&](size_t i) {
+        try {
+            TinyMipsCPU cpu;
+            cpu.setEndianness(options.endianness);
+            if (imageMode) {
+                vector<uint8_t> image = readMemoryImage(options.inputs[i]);
+                cpu.loadProgram(sharedProgram);
+                cpu.loadMemoryImage(image.data(), image.size());
+            } else {
+                cpu.loadProgram(loadProgramWords(options.inputs[i]));
+            }
+            runToCompletion(cpu, options, outcomes[i]);
+        } catch (const exception& e) {
+            outcomes[i].error = e.what();
+            // Some encoder messages end in a newline
+            while (!outcomes[i].error.empty() && outcomes[i].error.back() == '\n')
+                outcomes[i].error.pop_back();
+        }
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t failed = 0;
+    uint64_t instructions = 0;
+    for (size_t i = 0; i < outcomes.size(); ++i) {
+        const RunOutcome& outcome = outcomes[i];
+        if (!outcome.ok) {
+            ++failed;
+            cerr << "Error: " << options.inputs[i] << ": " << outcome.error << '\n';
+            continue;
+        }
+        instructions += outcome.steps;
+        cout << options.inputs[i] << ": " << outcome.steps << " instruction(s), state "
+             << hex << setw(16) << setfill('0') << outcome.stateHash << dec << setfill(' ')
+             << ", " << outcome.residentPages << " page(s)";
+        if (outcome.hitStepLimit)
+            cout << " (step limit reached)";
+        cout << '\n';
+    }
+
+    cout << "Batch: " << outcomes.size() - failed << " of " << outcomes.size() << " run(s), "
+         << failed << " failed, " << instructions << " instruction(s) in " << seconds * 1000.0
+         << " ms on " << min<size_t>(options.threads, outcomes.size()) << " thread(s)";
+    if (seconds > 0)
+        cout << " (" << static_cast<uint64_t>(instructions / seconds) << " instr/s)";
+    cout << endl;
+    return failed == 0 ? 0 : 1;
+}
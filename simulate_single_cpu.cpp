@@ -11,55 +11,445 @@
 ------------------------------------------------------------------------------*/
 #include "simulate_single_cpu.h"
 #include "tiny_mips_cpu.h"
+#include "object_file.h"
+#include "program_loader.h"
+#include "retire_trace.h"
+#include "timing_model.h"
+#include "line_table.h"
 #include <iostream>
-#include <fstream>
 #include <vector>
-#include <bitset>
+#include <string>
+#include <cstdlib>
+#include <cerrno>
+#include <cctype>
+#include <climits>
+#include <chrono>
+#include <memory>
+#include <fstream>
+#include <algorithm>
 
 using namespace std;
 
+// Command line settings applied after the program is loaded
+struct SimOptions {
+    string inputPath;
+    ExecEngine engine = ExecEngine::Step;
+    // Threaded engine runs fused instruction pairs
+    bool fusion = true;
+    // 0 keeps the default limit of one pass over the program
+    uint64_t maxSteps = 0;
+    // Run the JIT and the interpreter and compare final state
+    bool jitVerify = false;
+    TraceLevel traceLevel = TraceLevel::Full;
+    // Byte order of data memory words
+    Endianness endianness = Endianness::Big;
+    // Binary retire trace destination (empty = none)
+    string retireTracePath;
+    // Performance models run alongside the program
+    TimingConfig timing;
+    // Line table for the profile (empty = OUTPUT.lines if it exists)
+    string lineTablePath;
+    // Checkpoint after this many instructions, and every N (0 = never)
+    uint64_t checkpointAt = 0;
+    uint64_t checkpointEvery = 0;
+    // Checkpoints are written to PREFIX.STEPS.ckpt (empty = input path)
+    string checkpointPrefix;
+    // Checkpoint to resume from (empty = start at pc 0)
+    string restorePath;
+};
 
-int main(int argc, char* argv[]) {
-    DEBUG_MODE = false; 
-	// Check input file validity
-    if (argc != 2) {
-        cerr << "Usage: ./simulate_single_cpu <binary_file.txt>\n";
+static void printUsage() {
+    cerr << "Usage: ./simulate_single_cpu [options] <binary_file.txt | object_file>\n"
+         << "  --engine=step|threaded|jit  Interpreter to use (default step)\n"
+         << "  --no-fuse                   Threaded engine dispatches every instruction on its own\n"
+         << "  --max-steps=N               Stop after N instructions (default program length)\n"
+         << "  --endian=big|little         Byte order of data memory words (default big)\n"
+         << "  --trace=none|summary|changed|full\n"
+         << "                              Trace detail (default full; per-instruction\n"
+         << "                              levels apply to the step engine)\n"
+         << "  --retire-trace=FILE         Write a binary record per retired instruction\n"
+         << "                              (decode with tiny_mips_trace)\n"
+         << "  --jit-verify                Differential check of the JIT against the interpreter\n"
+         << "                              (honours --restore; not with checkpoints, retire\n"
+         << "                              traces or timing models)\n"
+         << "  --pipeline                  Estimate cycles on a 5-stage pipeline (with forwarding)\n"
+         << "  --no-forwarding             Pipeline without bypasses (implies --pipeline)\n"
+         << "  --branch-penalty=N          Cycles lost per taken beq (default 2, implies --pipeline)\n"
+         << "  --jump-penalty=N            Cycles lost per j (default 1, implies --pipeline)\n"
+         << "  --icache=SIZE:LINE:WAYS[:lru|fifo|random][:wb|wt]\n"
+         << "  --dcache=SIZE:LINE:WAYS[:lru|fifo|random][:wb|wt]\n"
+         << "                              Model an L1 instruction or data cache, e.g. 8K:32:2:lru:wb\n"
+         << "  --miss-penalty=N            Pipeline cycles per cache miss (default 10)\n"
+         << "  --predictor=not-taken|1bit|2bit|gshare[:HISTORY]\n"
+         << "                              Predict beq directions (gshare history default 8)\n"
+         << "  --predictor-bits=N          log2 of the predictor table size (default 10)\n"
+         << "  --btb=N                     Branch target buffer entries for j (default 64, 0 = none)\n"
+         << "  --profile                   Count instructions per pc and class and find hot loops\n"
+         << "  --line-table=FILE           Source lines for the profile (default INPUT.lines,\n"
+         << "                              written by tiny_mips_asm -g)\n"
+         << "  --checkpoint-at=N           Save the CPU state after N instructions\n"
+         << "  --checkpoint-every=N        Save the CPU state every N instructions\n"
+         << "  --checkpoint=PREFIX         Checkpoint files are PREFIX.STEPS.ckpt (default input path)\n"
+         << "  --restore=FILE              Resume from a checkpoint of the same program\n";
+}
+
+// Parses the decimal number after an option's '='. False if it is empty,
+// signed, followed by anything else or above limit.
+static bool parseCount(const char* text, uint64_t limit, uint64_t& value) {
+    if (!isdigit(static_cast<unsigned char>(text[0])))
+        return false;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed > limit)
+        return false;
+    value = parsed;
+    return true;
+}
+
+// Returns false on unknown options, bad values or a missing input path
+static bool parseOptions(int argc, char* argv[], SimOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--engine=step") {
+            options.engine = ExecEngine::Step;
+        } else if (arg == "--engine=threaded") {
+            options.engine = ExecEngine::Threaded;
+        } else if (arg == "--engine=jit") {
+            options.engine = ExecEngine::Jit;
+        } else if (arg == "--no-fuse") {
+            options.fusion = false;
+        } else if (arg == "--jit-verify") {
+            options.jitVerify = true;
+        } else if (arg == "--endian=big") {
+            options.endianness = Endianness::Big;
+        } else if (arg == "--endian=little") {
+            options.endianness = Endianness::Little;
+        } else if (arg.rfind("--trace=", 0) == 0) {
+            if (!parseTraceLevel(arg.substr(8), options.traceLevel))
+                return false;
+        } else if (arg.rfind("--retire-trace=", 0) == 0) {
+            options.retireTracePath = arg.substr(15);
+            if (options.retireTracePath.empty())
+                return false;
+        } else if (arg.rfind("--max-steps=", 0) == 0) {
+            // 0 would mean "use the default", so it is not a valid limit
+            if (!parseCount(arg.c_str() + 12, UINT64_MAX, options.maxSteps) || options.maxSteps == 0)
+                return false;
+        } else if (arg == "--pipeline") {
+            options.timing.pipelineEnabled = true;
+        } else if (arg == "--no-forwarding") {
+            options.timing.pipelineEnabled = true;
+            options.timing.pipeline.forwarding = false;
+        } else if (arg.rfind("--branch-penalty=", 0) == 0) {
+            uint64_t penalty = 0;
+            if (!parseCount(arg.c_str() + 17, UINT_MAX, penalty))
+                return false;
+            options.timing.pipelineEnabled = true;
+            options.timing.pipeline.branchPenalty = static_cast<unsigned>(penalty);
+        } else if (arg.rfind("--jump-penalty=", 0) == 0) {
+            uint64_t penalty = 0;
+            if (!parseCount(arg.c_str() + 15, UINT_MAX, penalty))
+                return false;
+            options.timing.pipelineEnabled = true;
+            options.timing.pipeline.jumpPenalty = static_cast<unsigned>(penalty);
+        } else if (arg.rfind("--icache=", 0) == 0) {
+            if (!parseCacheConfig(arg.substr(9), options.timing.instructionCache))
+                return false;
+            options.timing.instructionCacheEnabled = true;
+        } else if (arg.rfind("--dcache=", 0) == 0) {
+            if (!parseCacheConfig(arg.substr(9), options.timing.dataCache))
+                return false;
+            options.timing.dataCacheEnabled = true;
+        } else if (arg.rfind("--miss-penalty=", 0) == 0) {
+            uint64_t penalty = 0;
+            if (!parseCount(arg.c_str() + 15, UINT_MAX, penalty))
+                return false;
+            options.timing.instructionCache.missPenalty = static_cast<unsigned>(penalty);
+            options.timing.dataCache.missPenalty = static_cast<unsigned>(penalty);
+        } else if (arg.rfind("--predictor=", 0) == 0) {
+            if (!parsePredictorKind(arg.substr(12), options.timing.predictor))
+                return false;
+            options.timing.predictorEnabled = true;
+        } else if (arg.rfind("--predictor-bits=", 0) == 0) {
+            uint64_t bits = 0;
+            if (!parseCount(arg.c_str() + 17, 24, bits) || bits == 0)
+                return false;
+            options.timing.predictor.tableBits = static_cast<unsigned>(bits);
+            options.timing.predictorEnabled = true;
+        } else if (arg.rfind("--btb=", 0) == 0) {
+            uint64_t entries = 0;
+            if (!parseCount(arg.c_str() + 6, 1u << 24, entries) || (entries & (entries - 1)))
+                return false;
+            options.timing.predictor.btbEntries = static_cast<unsigned>(entries);
+            options.timing.predictorEnabled = true;
+        } else if (arg == "--profile") {
+            options.timing.profileEnabled = true;
+        } else if (arg.rfind("--line-table=", 0) == 0) {
+            options.lineTablePath = arg.substr(13);
+            if (options.lineTablePath.empty())
+                return false;
+            options.timing.profileEnabled = true;
+        } else if (arg.rfind("--checkpoint-at=", 0) == 0) {
+            if (!parseCount(arg.c_str() + 16, UINT64_MAX, options.checkpointAt) || options.checkpointAt == 0)
+                return false;
+        } else if (arg.rfind("--checkpoint-every=", 0) == 0) {
+            if (!parseCount(arg.c_str() + 19, UINT64_MAX, options.checkpointEvery)
+                    || options.checkpointEvery == 0)
+                return false;
+        } else if (arg.rfind("--checkpoint=", 0) == 0) {
+            options.checkpointPrefix = arg.substr(13);
+            if (options.checkpointPrefix.empty())
+                return false;
+        } else if (arg.rfind("--restore=", 0) == 0) {
+            options.restorePath = arg.substr(10);
+            if (options.restorePath.empty())
+                return false;
+        } else if (arg.rfind("--", 0) == 0 || !options.inputPath.empty()) {
+            return false;
+        } else {
+            options.inputPath = arg;
+        }
+    }
+    // --jit-verify compares final states only; outputs it cannot reproduce
+    // on both CPUs would silently describe a different run
+    if (options.jitVerify && (options.checkpointAt != 0 || options.checkpointEvery != 0
+                              || !options.retireTracePath.empty() || options.timing.enabled()))
+        return false;
+    return !options.inputPath.empty();
+}
+
+// Sets up one side of --jit-verify, resuming from --restore if given
+static void prepareVerifyRun(TinyMipsCPU& cpu, ExecEngine engine, const SimOptions& options) {
+    cpu.setEngine(engine);
+    cpu.setTrace(TraceLevel::None, TraceSink::standardOutput());
+    cpu.setEndianness(options.endianness);
+    if (options.maxSteps != 0)
+        cpu.setMaxSteps(options.maxSteps);
+    if (!options.restorePath.empty())
+        cpu.restoreCheckpoint(options.restorePath);
+}
+
+/*
+ * Differential test: runs the program once on the untraced step interpreter
+ * and once on the JIT, both from --restore if given, then compares pc,
+ * registers, memory and step counts. Returns 0 when both agree.
+ */
+static int verifyJit(TinyMipsCPU& cpu, const SimOptions& options) {
+    ostream& out = TraceSink::standardOutput().out();
+    // Copy first - cpu is reloaded from it below
+    vector<uint32_t> program = cpu.loadedProgram();
+
+    TinyMipsCPU reference;
+    reference.loadProgram(program);
+    cpu.loadProgram(move(program));
+    try {
+        prepareVerifyRun(reference, ExecEngine::Step, options);
+        prepareVerifyRun(cpu, ExecEngine::Jit, options);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << '\n';
         return 1;
     }
-    // Open file to read contents
-    ifstream inputFile(argv[1]);
-    if (!inputFile) {
-        cerr << "Error: Cannot open file " << argv[1] << '\n';
+    reference.executeProgram();
+    uint64_t referenceSteps = reference.stepsExecuted();
+    cpu.executeProgram();
+
+    string difference = reference.describeStateDifference(cpu);
+    if (difference.empty() && referenceSteps != cpu.stepsExecuted())
+        difference = "steps: " + to_string(referenceSteps) + " vs " + to_string(cpu.stepsExecuted());
+
+    if (!difference.empty()) {
+        out << "JIT verify: MISMATCH (interpreter vs jit) " << difference << '\n';
         return 1;
     }
+    out << "JIT verify: OK (" << referenceSteps << " instruction(s))\n";
+    return 0;
+}
+
+/*
+ * Finds the source lines and labels for the profile: the --line-table file,
+ * else INPUT.lines if the assembler wrote one, else the labels of an object
+ * file. Throws std::runtime_error if a line table cannot be read.
+ */
+static LineTable loadProfileLines(const SimOptions& options, const ObjectFile* object) {
+    string path = options.lineTablePath;
+    if (path.empty() && ifstream(options.inputPath + ".lines"))
+        path = options.inputPath + ".lines";
+    if (!path.empty())
+        return readLineTable(path);
+    LineTable table;
+    if (object) {
+        for (const ObjectSymbol& symbol : object->symbols())
+            table.labels.push_back({symbol.address, symbol.name});
+        sort(table.labels.begin(), table.labels.end(),
+             [](const LineLabel& a, const LineLabel& b) { return a.pc < b.pc; });
+    }
+    return table;
+}
+
+// Step count of the first checkpoint after the given one, 0 if there is none
+static uint64_t nextCheckpoint(const SimOptions& options, uint64_t after) {
+    uint64_t next = 0;
+    if (options.checkpointAt > after)
+        next = options.checkpointAt;
+    if (options.checkpointEvery != 0) {
+        uint64_t periodic = (after / options.checkpointEvery + 1) * options.checkpointEvery;
+        if (next == 0 || periodic < next)
+            next = periodic;
+    }
+    return next;
+}
+
+/*
+ * Runs the program, pausing at each requested step count to write a
+ * checkpoint. Throws std::runtime_error if a checkpoint cannot be written.
+ */
+static void executeWithCheckpoints(TinyMipsCPU& cpu, const SimOptions& options, ostream& out) {
+    const string& prefix = options.checkpointPrefix.empty() ? options.inputPath : options.checkpointPrefix;
+    for (uint64_t next = nextCheckpoint(options, cpu.stepsExecuted()); next != 0;
+         next = nextCheckpoint(options, next)) {
+        if (!cpu.executeUntil(next))
+            return;
+        string path = prefix + "." + to_string(next) + ".ckpt";
+        cpu.saveCheckpoint(path);
+        if (options.traceLevel != TraceLevel::None)
+            out << "Checkpoint at " << next << " instruction(s): " << path << '\n';
+    }
+    cpu.executeProgram();
+}
+
+// Shows the initial state, runs the loaded program and shows the final state
+static int runLoadedProgram(TinyMipsCPU& cpu, const SimOptions& options, const LineTable& lines) {
+    if (options.jitVerify)
+        return verifyJit(cpu, options);
 
-    // Create vector for 32 bit instr
-    vector<uint32_t> instructions;
-    // String for each line read
-    string line;
-    while (getline(inputFile, line)) {
-        if (line.length() == 32) {
-            uint32_t binary = bitset<32>(line).to_ulong();
-            instructions.push_back(binary);
+    // Every line of output goes through the CPU's buffered trace sink
+    TraceSink& sink = TraceSink::standardOutput();
+    ostream& out = sink.out();
+    const TraceLevel level = options.traceLevel;
+    cpu.setTrace(level, sink);
+    cpu.setEngine(options.engine);
+    cpu.setFusion(options.fusion);
+    cpu.setEndianness(options.endianness);
+    if (options.maxSteps != 0)
+        cpu.setMaxSteps(options.maxSteps);
+    // The checkpoint brings its own byte order and step count
+    if (!options.restorePath.empty()) {
+        try {
+            cpu.restoreCheckpoint(options.restorePath);
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << '\n';
+            return 1;
         }
+        if (level != TraceLevel::None)
+            out << "Restored " << options.restorePath << " at " << cpu.stepsExecuted() << " instruction(s)\n";
     }
-    TinyMipsCPU cpu;
 
-    cout << "Initial Register State:\n";
-    cpu.displayRegisters();
+    if (level == TraceLevel::Full) {
+        out << "Initial Register State:\n";
+        cpu.displayRegisters();
 
-    cout << "\nInitial Memory State:\n";
-    cpu.displayMemory(0, 64);
+        out << "\nInitial Memory State:\n";
+        cpu.displayMemory(0, 64);
+    }
 
-    // Load instruction vector with the bitsets
-    cpu.loadProgram(instructions);
-    cpu.executeProgram();
+    chrono::duration<double> elapsed{};
+    unique_ptr<RetireTraceWriter> retireTrace;
+    unique_ptr<TimingModel> timing;
+    if (options.timing.enabled()) {
+        timing.reset(new TimingModel(options.timing));
+        cpu.setTimingModel(timing.get());
+        if (timing->profiler())
+            timing->profiler()->setLineTable(lines);
+    }
+    try {
+        if (!options.retireTracePath.empty()) {
+            retireTrace.reset(new RetireTraceWriter(options.retireTracePath));
+            cpu.setRetireTrace(retireTrace.get());
+        }
+
+        auto start = chrono::steady_clock::now();
+        executeWithCheckpoints(cpu, options, out);
+        elapsed = chrono::steady_clock::now() - start;
+
+        if (retireTrace) {
+            retireTrace->flush();
+            cpu.setRetireTrace(nullptr);
+        }
+    } catch (const exception& e) {
+        sink.flush();
+        cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
 
-    cout << "\nFinal Register State:\n";
-    cpu.displayRegisters();
+    // Only the state dumps depend on the trace level; the timing and
+    // profile reports are what a --trace=none run is for
+    if (level != TraceLevel::None) {
+        out << "\nFinal Register State:\n";
+        cpu.displayRegisters();
 
-    cout << "\nFinal Memory State:\n";
-    cpu.displayMemory(0, 64);  
+        out << "\nFinal Memory State:\n";
+        cpu.displayMemory(0, 64);  
+    }
 
+    if (level != TraceLevel::Full && level != TraceLevel::None) {
+        double seconds = elapsed.count();
+        out << "\nExecuted " << cpu.stepsExecuted() << " instruction(s) in "
+            << seconds * 1000.0 << " ms";
+        if (seconds > 0)
+            out << " (" << static_cast<uint64_t>(cpu.stepsExecuted() / seconds) << " instr/s)";
+        out << '\n';
+        if (cpu.fusedPairsExecuted() != 0)
+            out << "Fused pairs: " << cpu.fusedPairsExecuted() << " (" << 2 * cpu.fusedPairsExecuted()
+                << " instruction(s) retired two per dispatch)\n";
+        out << "Resident memory: " << cpu.residentPages() << " page(s) of "
+            << PagedMemory::PAGE_SIZE / 1024 << " KiB\n";
+        if (retireTrace)
+            out << "Wrote " << retireTrace->recordCount() << " retire record(s) to "
+                << options.retireTracePath << '\n';
+    }
+    if (timing) {
+        if (level != TraceLevel::None)
+            out << '\n';
+        timing->report(out);
+    }
+    sink.flush();
     return 0;
+}
+
+int main(int argc, char* argv[]) {
+	// Check input file validity
+    SimOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    const char* inputPath = options.inputPath.c_str();
+    TinyMipsCPU cpu;
+    LineTable lines;
+
+    // Packed object files are mapped and handed to the CPU without parsing
+    if (isObjectFile(inputPath)) {
+        try {
+            ObjectFile object(inputPath);
+            cpu.loadProgram(object.text(), object.textCount());
+            if (options.timing.profileEnabled)
+                lines = loadProfileLines(options, &object);
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << '\n';
+            return 1;
+        }
+        return runLoadedProgram(cpu, options, lines);
+    }
+
+    // Bitstring text, one 32-bit instruction per line
+    try {
+        cpu.loadProgram(readProgramFile(inputPath));
+        if (options.timing.profileEnabled)
+            lines = loadProfileLines(options, nullptr);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+    return runLoadedProgram(cpu, options, lines);
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*------------------------------------------------------------------------------
+  File:        source_scanner.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements the memory-mapped source file and the SSE2/AVX2
+               structural byte scanner with its scalar fallback.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - source_scanner.h
+    - <stdexcept>, <immintrin.h> on x86
+    - POSIX mmap (<sys/mman.h>, <sys/stat.h>, <fcntl.h>, <unistd.h>)
+  -----------------------------------------------------------------------------*/
+#include "source_scanner.h"
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(TINY_MIPS_NO_SIMD)
+#define TINY_MIPS_SIMD_SCANNER 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+MappedSource::MappedSource(const string& path) : mapping(nullptr), size(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Cannot open input file: " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        throw runtime_error("Cannot open input file: " + path);
+    }
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0) {
+        mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            close(fd);
+            throw runtime_error("Cannot map input file: " + path);
+        }
+        // The parser reads the file front to back exactly once
+        madvise(mapping, size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+}
+
+MappedSource::~MappedSource() {
+    if (mapping) {
+        munmap(mapping, size);
+    }
+}
+
+// Byte loop used for short tails and on hosts without SSE2
+static size_t scanScalar(const char* data, size_t size, uint32_t* marks, uint32_t base) {
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        char c = data[i];
+        if (c == '\n' || c == '#' || c == ':' || c == ',')
+            marks[count++] = base + static_cast<uint32_t>(i);
+    }
+    return count;
+}
+
+#ifdef TINY_MIPS_SIMD_SCANNER
+// Appends the offset of every set bit of a compare mask
+static inline size_t emitMarks(uint32_t mask, uint32_t base, uint32_t* marks, size_t count) {
+    while (mask != 0) {
+        marks[count++] = base + static_cast<uint32_t>(__builtin_ctz(mask));
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+static size_t scanSse2(const char* data, size_t size, uint32_t* marks) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i hash = _mm_set1_epi8('#');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, hash)),
+            _mm_or_si128(_mm_cmpeq_epi8(block, colon), _mm_cmpeq_epi8(block, comma)));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        count = emitMarks(mask, static_cast<uint32_t>(i), marks, count);
+    }
+    return count + scanScalar(data + i, size - i, marks + count, static_cast<uint32_t>(i));
+}
+
+// Compiled for AVX2 only; called after the run-time CPU check
+__attribute__((target("avx2")))
+static size_t scanAvx2(const char* data, size_t size, uint32_t* marks) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i hash = _mm256_set1_epi8('#');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, newline), _mm256_cmpeq_epi8(block, hash)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, colon), _mm256_cmpeq_epi8(block, comma)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        count = emitMarks(mask, static_cast<uint32_t>(i), marks, count);
+    }
+    return count + scanScalar(data + i, size - i, marks + count, static_cast<uint32_t>(i));
+}
+#else
+static size_t scanPortable(const char* data, size_t size, uint32_t* marks) {
+    return scanScalar(data, size, marks, 0);
+}
+#endif
+
+struct ScannerChoice {
+    size_t (*scan)(const char*, size_t, uint32_t*);
+    const char* name;
+};
+
+// Picked once per process; static initialization is thread-safe
+static const ScannerChoice& scanner() {
+    static const ScannerChoice choice = [] {
+#ifdef TINY_MIPS_SIMD_SCANNER
+        if (__builtin_cpu_supports("avx2"))
+            return ScannerChoice{scanAvx2, "avx2"};
+        return ScannerChoice{scanSse2, "sse2"};
+#else
+        return ScannerChoice{scanPortable, "scalar"};
+#endif
+    }();
+    return choice;
+}
+
+size_t scanStructure(const char* data, size_t size, uint32_t* marks) {
+    return scanner().scan(data, size, marks);
+}
+
+const char* scannerName() {
+    return scanner().name;
+}
@@ -0,0 +1,76 @@
+/*------------------------------------------------------------------------------
+  File:        source_scanner.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the memory-mapped assembly source and the vectorized
+               scanner that finds the structural bytes of each line.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               The two-pass front end maps the .s file instead of reading it
+               into a string, then classifies its bytes in blocks of 16 (SSE2)
+               or 32 (AVX2) at a time. The scanner reports the offset of every
+               newline, '#', ':' and ',' so parseSource can cut lines, strip
+               comments, find labels and split operand fields without
+               searching each line again.
+
+               AVX2 is used when the CPU supports it at run time, SSE2 on any
+               other x86-64 host, and a byte loop everywhere else. Define
+               TINY_MIPS_NO_SIMD to force the byte loop.
+
+  Dependencies:
+    - <string>, <string_view>, <cstddef>, <cstdint>
+    - POSIX mmap
+  -----------------------------------------------------------------------------*/
+#ifndef SOURCE_SCANNER_H
+#define SOURCE_SCANNER_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Read-only mapping of an input file. Tokens from parseSource point
+ * straight into the mapping, so it must outlive them. Also used to map
+ * the incremental assembly cache.
+ */
+class MappedSource {
+public:
+    // Maps the whole file; throws std::runtime_error if it cannot be opened
+    explicit MappedSource(const std::string& path);
+    ~MappedSource();
+
+    MappedSource(const MappedSource&) = delete;
+    MappedSource& operator=(const MappedSource&) = delete;
+
+    // File contents (empty for an empty file)
+    std::string_view view() const {
+        return std::string_view(static_cast<const char*>(mapping), size);
+    }
+
+private:
+    void* mapping;
+    size_t size;
+};
+
+/**
+ * Finds every newline, '#', ':' and ',' in a block of source text.
+ *
+ * @param data  - Start of the block
+ * @param size  - Block length in bytes (must fit in 32 bits)
+ * @param marks - Receives the offsets in ascending order; needs room for
+ *                size entries
+ * @return Number of offsets written
+ */
+size_t scanStructure(const char* data, size_t size, uint32_t* marks);
+
+/**
+ * @return Name of the scanner selected for this CPU: "avx2", "sse2" or "scalar"
+ */
+const char* scannerName();
+
+#endif // SOURCE_SCANNER_H
@@ -0,0 +1,116 @@
+/*------------------------------------------------------------------------------
+  File:        stream_assembler.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements the single-pass streaming assembler with
+               forward-reference fixups.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - stream_assembler.h
+    - parser.h, encoder.h, converters.h, bitstring_codec.h
+    - <vector>, <stdexcept>
+  -----------------------------------------------------------------------------*/
+#include "stream_assembler.h"
+#include "parser.h"
+#include "encoder.h"
+#include "converters.h"
+#include "bitstring_codec.h"
+#include <vector>
+#include <stdexcept>
+
+using namespace std;
+
+TextWordSink::TextWordSink(const string& path)
+    : out(path, ios::binary), path(path) {
+    if (!out) {
+        throw runtime_error("Cannot open output file: " + path);
+    }
+}
+
+void TextWordSink::append(uint32_t word) {
+    char line[BITSTRING_LINE_BYTES];
+    formatBitstrings(&word, 1, line);
+    out.write(line, BITSTRING_LINE_BYTES);
+}
+
+void TextWordSink::patch(size_t index, uint32_t word) {
+    streampos end = out.tellp();
+    char line[BITSTRING_LINE_BYTES];
+    formatBitstrings(&word, 1, line);
+    out.seekp(static_cast<streamoff>(index * BITSTRING_LINE_BYTES));
+    // The bits only; the newline already in the file stays
+    out.write(line, BITSTRING_LINE_BYTES - 1);
+    out.seekp(end);
+}
+
+void TextWordSink::finish(const unordered_map<string, uint32_t>&) {
+    out.flush();
+    if (!out) {
+        throw runtime_error("Failed writing output file: " + path);
+    }
+}
+
+// A beq/j already written whose label was not defined at the time
+struct Fixup {
+    size_t index;
+    uint32_t word;
+};
+
+/**
+ * Reads, encodes and writes one line at a time. Only the symbol table and
+ * the fixups for labels not seen yet are kept between lines.
+ */
+size_t assembleStream(istream& in, WordSink& out,
+                      unordered_map<string, uint32_t>& symbolTable) {
+    unordered_map<string, vector<Fixup>> pending;
+    SourceLine parsed;
+    string line;
+    string unresolved;
+    size_t lineNumber = 0;
+    size_t count = 0;
+
+    while (getline(in, line)) {
+        ++lineNumber;
+        parseLine(line, parsed);
+        uint32_t pc = static_cast<uint32_t>(count * 4);
+
+        try {
+            if (parsed.hasLabel) {
+                if (!symbolTable.emplace(parsed.label, pc).second)
+                    throw runtime_error("Duplicate label: " + parsed.label);
+
+                // Patch every earlier branch or jump waiting on this label
+                auto waiting = pending.find(parsed.label);
+                if (waiting != pending.end()) {
+                    for (const Fixup& fixup : waiting->second) {
+                        uint32_t fixupPc = static_cast<uint32_t>(fixup.index * 4);
+                        out.patch(fixup.index, resolveLabelReference(fixup.word, fixupPc, pc));
+                    }
+                    pending.erase(waiting);
+                }
+            }
+
+            if (!parsed.hasInstruction)
+                continue;
+
+            unresolved.clear();
+            uint32_t word = encodeInstruction(parsed.token, pc, symbolTable, &unresolved);
+            if (!unresolved.empty())
+                pending[unresolved].push_back({count, word});
+            out.append(word);
+            ++count;
+        } catch (const exception& e) {
+            throw runtime_error("Line " + to_string(lineNumber) + ": " + e.what());
+        }
+    }
+
+    if (!pending.empty()) {
+        throw runtime_error("Undefined label: " + pending.begin()->first);
+    }
+    out.finish(symbolTable);
+    return count;
+}
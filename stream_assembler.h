@@ -0,0 +1,98 @@
+/*------------------------------------------------------------------------------
+  File:        stream_assembler.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the single-pass streaming assembler and the output
+               sinks it writes encoded words to.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               The default assembler keeps every source line, every token and
+               every encoded word in memory at once. The streaming assembler
+               reads one line at a time and writes each instruction as soon
+               as it is encoded. A beq or j whose label is not defined yet is
+               written with an empty label field and remembered in a fixup
+               list; when the label shows up the word is patched in place in
+               the output. Memory use grows with the labels and the pending
+               forward references, not with the program size.
+
+               Unlike the two-pass assembler, a label may only be defined
+               once, because earlier branches have already been resolved
+               against it.
+
+  Dependencies:
+    - object_file.h: object output
+    - <istream>, <fstream>, <string>, <unordered_map>, <cstdint>, <cstddef>
+  -----------------------------------------------------------------------------*/
+#ifndef STREAM_ASSEMBLER_H
+#define STREAM_ASSEMBLER_H
+
+#include <istream>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "object_file.h"
+
+// Destination for the words produced by assembleStream
+class WordSink {
+public:
+    virtual ~WordSink() = default;
+    // Writes the next instruction word
+    virtual void append(uint32_t word) = 0;
+    // Rewrites a word appended earlier, once its label is known
+    virtual void patch(size_t index, uint32_t word) = 0;
+    // Called once after the last word with the complete symbol table
+    virtual void finish(const std::unordered_map<std::string, uint32_t>& symbolTable) = 0;
+};
+
+// One 32-character bitstring per line (fixed 33-byte lines, so patchable)
+class TextWordSink : public WordSink {
+public:
+    // Creates or truncates the file; throws std::runtime_error
+    explicit TextWordSink(const std::string& path);
+
+    void append(uint32_t word) override;
+    void patch(size_t index, uint32_t word) override;
+    void finish(const std::unordered_map<std::string, uint32_t>& symbolTable) override;
+
+private:
+    std::ofstream out;
+    std::string path;
+};
+
+// Packed binary object file (see object_file.h)
+class ObjectWordSink : public WordSink {
+public:
+    // Creates or truncates the file; throws std::runtime_error
+    explicit ObjectWordSink(const std::string& path) : writer(path) { }
+
+    void append(uint32_t word) override { writer.appendWord(word); }
+    void patch(size_t index, uint32_t word) override { writer.patchWord(index, word); }
+    void finish(const std::unordered_map<std::string, uint32_t>& symbolTable) override {
+        writer.finish(symbolTable);
+    }
+
+private:
+    ObjectFileWriter writer;
+};
+
+/**
+ * Assembles source text in a single pass, writing each word to the sink as
+ * soon as it is encoded and patching forward branch/jump targets later.
+ *
+ * @param in          - Assembly source, read line by line
+ * @param out         - Receives the encoded words
+ * @param symbolTable - Filled with every label and its address
+ * @return Number of instructions written
+ * @throws std::runtime_error on a bad instruction (with its line number),
+ *         a duplicate label or a label that is never defined
+ */
+size_t assembleStream(std::istream& in, WordSink& out,
+                      std::unordered_map<std::string, uint32_t>& symbolTable);
+
+#endif // STREAM_ASSEMBLER_H
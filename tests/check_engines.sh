@@ -0,0 +1,84 @@
+#!/bin/sh
+#------------------------------------------------------------------------------
+# File:        tests/check_engines.sh
+# Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+# Purpose:     Differential check of the three simulator engines.
+#
+# Description:
+#              Assembles every test_*.s program and a set of tiny_mips_gen
+#              workloads, then for each one:
+#
+#              - runs --jit-verify (JIT against the interpreter, block by block)
+#              - compares the --trace=summary final state of --engine=step,
+#                --engine=threaded (fused and --no-fuse) and --engine=jit
+#
+#              Generated workloads are also run again from a checkpoint taken
+#              after 1000 instructions.
+#
+#              The generated set covers taken branches and nested loops
+#              (loops, mixed), never-taken beq with forward j (labels), and a
+#              mixed program big enough to fill the JIT's 4 MiB code cache
+#              so blocks are compiled again after a flush.
+#
+#              Run from the repository root after make (make check does both).
+#              Exits non-zero on the first mismatch.
+#------------------------------------------------------------------------------
+
+SIM=./simulate_single_cpu
+ASM=./tiny_mips_asm
+GEN=./tiny_mips_gen
+
+WORK=$(mktemp -d) || exit 1
+trap 'rm -rf "$WORK"' EXIT
+
+fail() {
+    echo "FAIL: $*"
+    exit 1
+}
+
+# Summary output and errors, without the wall-clock line and the fusion count
+finalState() {
+    "$SIM" --trace=summary "$@" 2>&1 | grep -v " ms (" | grep -v "^Fused pairs"
+}
+
+# check NAME PROGRAM [SIMULATOR OPTIONS]
+check() {
+    label=$1
+    program=$2
+    shift 2
+    "$SIM" --jit-verify "$@" "$program" > "$WORK/verify.out" 2>&1 || fail "$label: --jit-verify exited non-zero"
+    grep -q "^JIT verify: OK" "$WORK/verify.out" || fail "$label: $(tail -n 1 "$WORK/verify.out")"
+
+    finalState --engine=step "$@" "$program" > "$WORK/step.out"
+    for engine in "--engine=threaded" "--engine=threaded --no-fuse" "--engine=jit"; do
+        # $engine is split on purpose
+        finalState $engine "$@" "$program" > "$WORK/engine.out"
+        cmp -s "$WORK/step.out" "$WORK/engine.out" || fail "$label: $engine differs from --engine=step"
+    done
+    echo "ok   $label"
+}
+
+for source in test_*.s; do
+    "$ASM" "$source" "$WORK/program.txt" > /dev/null || fail "$source does not assemble"
+    check "$source" "$WORK/program.txt"
+done
+
+# NAME:GENERATOR ARGUMENTS (no spaces inside an argument)
+for workload in \
+    "loops:--depth=4 --iterations=6 --body=12 loops" \
+    "labels:--seed=7 --size=20000 labels" \
+    "memory:--count=300 --stride=12 memory" \
+    "mixed:--seed=3 mixed" \
+    "refill:--size=300000 mixed"; do
+    name=${workload%%:*}
+    "$GEN" ${workload#*:} "$WORK/gen.s" > /dev/null || fail "gen $name"
+    "$ASM" "$WORK/gen.s" "$WORK/gen.txt" > /dev/null || fail "gen $name does not assemble"
+    check "gen $name" "$WORK/gen.txt" --max-steps=100000000
+    check "gen $name, little-endian" "$WORK/gen.txt" --max-steps=100000000 --endian=little
+    # Every engine, and both sides of --jit-verify, resume from a checkpoint
+    "$SIM" --trace=none --max-steps=100000000 --checkpoint-at=1000 --checkpoint="$WORK/gen" "$WORK/gen.txt" \
+        || fail "gen $name: checkpoint"
+    check "gen $name, restored" "$WORK/gen.txt" --max-steps=100000000 --restore="$WORK/gen.1000.ckpt"
+done
+
+echo "Engine check passed"
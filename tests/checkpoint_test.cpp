@@ -0,0 +1,237 @@
+/*------------------------------------------------------------------------------
+  File:        tests/checkpoint_test.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Round-trip and rejection checks for CPU checkpoints.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Runs a loop that stores across many pages part way, saves a
+               checkpoint and restores it into a fresh CPU, for big and
+               little-endian guests:
+
+               - stateHash, step count and byte order must survive the
+                 round trip, in the host's byte order and in a copy of the
+                 file rewritten in the other one
+               - both CPUs, and a run that was never interrupted, must then
+                 finish with the same stateHash
+
+               Files with an unaligned pc, a page count or offsets past the
+               end (including ones that wrap when added), a missing page or
+               a different program must be rejected without changing the
+               CPU. Links libtinymips.a; exits non-zero on failure.
+
+  Dependencies:
+    - tiny_mips.h, checkpoint.h
+    - <iostream>, <fstream>, <sstream>, <string>, <vector>, <stdexcept>,
+      <cstddef>, <cstring>, <cstdlib>, <unistd.h>
+  -----------------------------------------------------------------------------*/
+#include "../tiny_mips.h"
+#include "../checkpoint.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+
+// Stores a running sum every 4100 bytes, so the data spans many pages
+static const char* const PROGRAM =
+    "        addi $t0, $zero, 40\n"
+    "        addi $a0, $zero, 8\n"
+    "loop:   beq $t0, $zero, done\n"
+    "        add $s0, $s0, $t0\n"
+    "        sw $s0, 0($a0)\n"
+    "        lw $t1, 0($a0)\n"
+    "        add $s1, $s1, $t1\n"
+    "        addi $a0, $a0, 4100\n"
+    "        addi $t0, $t0, -1\n"
+    "        j loop\n"
+    "done:   sw $s1, 4($zero)\n";
+
+static const uint64_t CHECKPOINT_STEP = 123;
+
+static int failures = 0;
+
+static void expect(bool condition, const string& what) {
+    if (!condition) {
+        cout << "FAIL: " << what << '\n';
+        ++failures;
+    }
+}
+
+static TraceSink& quietSink() {
+    static TraceSink sink(1, 256);
+    return sink;
+}
+
+static void loadCpu(TinyMipsCPU& cpu, const vector<uint32_t>& program, Endianness order) {
+    cpu.loadProgram(program);
+    cpu.setTrace(TraceLevel::None, quietSink());
+    cpu.setEndianness(order);
+    cpu.setMaxSteps(1000000);
+}
+
+static string readFile(const string& path) {
+    ifstream in(path, ios::binary);
+    stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+static void writeFile(const string& path, const string& bytes) {
+    ofstream out(path, ios::binary | ios::trunc);
+    out.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+}
+
+template <typename T>
+static T byteSwap(T value) {
+    T swapped;
+    const char* from = reinterpret_cast<const char*>(&value);
+    char* to = reinterpret_cast<char*>(&swapped);
+    for (size_t i = 0; i < sizeof(T); ++i)
+        to[i] = from[sizeof(T) - 1 - i];
+    return swapped;
+}
+
+template <typename T>
+static void swapAt(string& bytes, size_t offset) {
+    T value;
+    memcpy(&value, &bytes[offset], sizeof(T));
+    value = byteSwap(value);
+    memcpy(&bytes[offset], &value, sizeof(T));
+}
+
+// The same checkpoint as written by a host of the other byte order
+static string otherHostOrder(string bytes) {
+    CheckpointHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    for (uint32_t i = 0; i < header.pageCount; ++i)
+        swapAt<uint32_t>(bytes, header.pageTableOffset + i * sizeof(uint32_t));
+    swapAt<uint16_t>(bytes, offsetof(CheckpointHeader, version));
+    bytes[offsetof(CheckpointHeader, endianness)] ^= 1;
+    swapAt<uint32_t>(bytes, offsetof(CheckpointHeader, pc));
+    swapAt<uint32_t>(bytes, offsetof(CheckpointHeader, pageCount));
+    swapAt<uint64_t>(bytes, offsetof(CheckpointHeader, steps));
+    swapAt<uint64_t>(bytes, offsetof(CheckpointHeader, programHash));
+    swapAt<uint64_t>(bytes, offsetof(CheckpointHeader, programWords));
+    for (size_t i = 0; i < 32; ++i)
+        swapAt<uint32_t>(bytes, offsetof(CheckpointHeader, registers) + i * sizeof(uint32_t));
+    swapAt<uint64_t>(bytes, offsetof(CheckpointHeader, pageTableOffset));
+    swapAt<uint64_t>(bytes, offsetof(CheckpointHeader, pageDataOffset));
+    return bytes;
+}
+
+// Restores a saved file into a fresh CPU and finishes the run from there
+static void checkRestore(const string& name, const string& path, const vector<uint32_t>& program,
+                         Endianness order, uint64_t savedHash, uint64_t finalHash) {
+    TinyMipsCPU cpu;
+    // The checkpoint brings its own byte order
+    loadCpu(cpu, program, order == Endianness::Big ? Endianness::Little : Endianness::Big);
+    try {
+        cpu.restoreCheckpoint(path);
+    } catch (const exception& e) {
+        expect(false, name + ": restore failed: " + e.what());
+        return;
+    }
+    expect(cpu.stateHash() == savedHash, name + ": stateHash differs after restore");
+    expect(cpu.stepsExecuted() == CHECKPOINT_STEP, name + ": step count differs after restore");
+    expect(cpu.endianness() == order, name + ": byte order differs after restore");
+    cpu.executeProgram();
+    expect(cpu.stateHash() == finalHash, name + ": resumed run ends in a different state");
+}
+
+// Each corruption must make restoreCheckpoint throw and leave the CPU alone
+static void checkRejected(const string& name, const string& path, const string& bytes,
+                          const vector<uint32_t>& program) {
+    writeFile(path, bytes);
+    TinyMipsCPU cpu;
+    loadCpu(cpu, program, Endianness::Big);
+    cpu.executeUntil(7);
+    uint64_t before = cpu.stateHash();
+    bool threw = false;
+    try {
+        cpu.restoreCheckpoint(path);
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    expect(threw, name + ": corrupt checkpoint accepted");
+    expect(cpu.stateHash() == before && cpu.stepsExecuted() == 7, name + ": rejected restore changed the CPU");
+}
+
+template <typename T>
+static string patched(string bytes, size_t offset, T value) {
+    memcpy(&bytes[offset], &value, sizeof(T));
+    return bytes;
+}
+
+int main() {
+    char pathTemplate[] = "/tmp/tiny_mips_ckptXXXXXX";
+    int fd = mkstemp(pathTemplate);
+    if (fd < 0) {
+        cerr << "Error: Cannot create a temporary file\n";
+        return 1;
+    }
+    close(fd);
+    const string path = pathTemplate;
+    const vector<uint32_t> program = assembleSource(PROGRAM);
+
+    for (Endianness order : {Endianness::Big, Endianness::Little}) {
+        const string orderName = order == Endianness::Big ? "big-endian" : "little-endian";
+
+        TinyMipsCPU straight;
+        loadCpu(straight, program, order);
+        straight.executeProgram();
+
+        TinyMipsCPU cpu;
+        loadCpu(cpu, program, order);
+        expect(cpu.executeUntil(CHECKPOINT_STEP), orderName + ": program ended before the checkpoint");
+        cpu.saveCheckpoint(path);
+        uint64_t savedHash = cpu.stateHash();
+        cpu.executeProgram();
+        expect(cpu.stateHash() == straight.stateHash(), orderName + ": saving changed the run");
+
+        string bytes = readFile(path);
+        checkRestore(orderName, path, program, order, savedHash, straight.stateHash());
+        writeFile(path, otherHostOrder(bytes));
+        checkRestore(orderName + ", other host order", path, program, order, savedHash, straight.stateHash());
+
+        CheckpointHeader header;
+        memcpy(&header, bytes.data(), sizeof(header));
+        expect(header.pageCount > 1, orderName + ": checkpoint should hold several pages");
+        checkRejected(orderName + ", unaligned pc", path,
+                      patched(bytes, offsetof(CheckpointHeader, pc), header.pc + 2), program);
+        checkRejected(orderName + ", page count past the table", path,
+                      patched(bytes, offsetof(CheckpointHeader, pageCount), UINT32_MAX), program);
+        checkRejected(orderName + ", page table past the data", path,
+                      patched(bytes, offsetof(CheckpointHeader, pageTableOffset), UINT64_MAX - 8), program);
+        checkRejected(orderName + ", data offset that wraps", path,
+                      patched(bytes, offsetof(CheckpointHeader, pageDataOffset), UINT64_MAX - 4095), program);
+        checkRejected(orderName + ", data past the end", path,
+                      patched(bytes, offsetof(CheckpointHeader, pageDataOffset),
+                              header.pageDataOffset + PagedMemory::PAGE_SIZE), program);
+        checkRejected(orderName + ", missing page", path,
+                      bytes.substr(0, bytes.size() - PagedMemory::PAGE_SIZE), program);
+        checkRejected(orderName + ", bad magic", path, patched(bytes, 0, 'X'), program);
+
+        // A program one instruction longer must not accept the file
+        vector<uint32_t> other = program;
+        other.push_back(program.back());
+        checkRejected(orderName + ", different program", path, bytes, other);
+    }
+
+    unlink(path.c_str());
+    if (failures != 0)
+        return 1;
+    cout << "Checkpoint check passed\n";
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*------------------------------------------------------------------------------
+  File:        tests/codec_test.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Round-trip checks for the bitstring codec.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               make check builds this file three times against
+               bitstring_codec.cpp: as is (AVX2 when the CPU has it), with
+               TINY_MIPS_NO_AVX2 (SSE2) and with TINY_MIPS_NO_SIMD (bit loop).
+               Each build checks, against a plain reference formatter:
+
+               - formatBitstrings on edge and random words, for counts that
+                 end inside and on SIMD block boundaries
+               - parseBitstrings of that text, and of the same words with
+                 CRLF endings, blank and '#' lines and no final newline
+               - that every non-'0'/'1' byte at every position of a line is
+                 rejected, naming the right line, as are short and long lines
+
+               The two forced builds also check that the codec they asked
+               for is the one in use. Exits non-zero on failure.
+
+  Dependencies:
+    - bitstring_codec.h
+    - <iostream>, <string>, <vector>, <stdexcept>, <cstdint>
+  -----------------------------------------------------------------------------*/
+#include "../bitstring_codec.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+
+using namespace std;
+
+// Codec the build flags force, or nullptr when the CPU decides
+#if defined(TINY_MIPS_NO_SIMD) || !defined(__SSE2__)
+static const char* const FORCED_CODEC = "scalar";
+#elif defined(TINY_MIPS_NO_AVX2)
+static const char* const FORCED_CODEC = "sse2";
+#else
+static const char* const FORCED_CODEC = nullptr;
+#endif
+
+static int failures = 0;
+
+static void expect(bool condition, const string& what) {
+    if (!condition) {
+        cout << "FAIL: " << what << '\n';
+        ++failures;
+    }
+}
+
+// Same generator as tiny_mips_gen, so the words are the same on every host
+static uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// One line per word, most significant bit first, without the codec
+static string referenceLine(uint32_t word) {
+    string line;
+    for (int bit = 31; bit >= 0; --bit)
+        line += ((word >> bit) & 1) ? '1' : '0';
+    return line;
+}
+
+static string referenceText(const vector<uint32_t>& words, const string& newline) {
+    string text;
+    for (uint32_t word : words)
+        text += referenceLine(word) + newline;
+    return text;
+}
+
+// Parses text expecting words back; name describes the case
+static void expectParse(const string& text, const vector<uint32_t>& words, const string& name) {
+    try {
+        expect(parseBitstrings(text, "test") == words, name + ": parsed words differ");
+    } catch (const exception& e) {
+        expect(false, name + ": " + e.what());
+    }
+}
+
+// Parses text expecting a malformed-line error at line
+static void expectMalformed(const string& text, size_t line, const string& name) {
+    try {
+        parseBitstrings(text, "test");
+        expect(false, name + ": accepted");
+    } catch (const runtime_error& e) {
+        string message = e.what();
+        expect(message.find("at line " + to_string(line) + ":") != string::npos,
+               name + ": wrong error: " + message);
+    }
+}
+
+static void checkRoundTrip(const vector<uint32_t>& words) {
+    const string name = to_string(words.size()) + " word(s)";
+    string text = formatBitstrings(words);
+    expect(text == referenceText(words, "\n"), name + ": formatted text differs");
+    expectParse(text, words, name);
+    expectParse(referenceText(words, "\r\n"), words, name + ", CRLF");
+    if (!words.empty()) {
+        expectParse(text.substr(0, text.size() - 1), words, name + ", no final newline");
+        string crlf = referenceText(words, "\r\n");
+        expectParse(crlf.substr(0, crlf.size() - 2) + "\r", words, name + ", CRLF, no final newline");
+    }
+
+    // Blank, comment and CRLF lines scattered between regular runs
+    string mixed = "# header\n\n";
+    for (size_t i = 0; i < words.size(); ++i) {
+        mixed += referenceLine(words[i]) + (i % 7 == 3 ? "\r\n" : "\n");
+        if (i % 11 == 5)
+            mixed += "\n";
+        if (i % 13 == 9)
+            mixed += "# note\r\n";
+    }
+    expectParse(mixed, words, name + ", mixed lines");
+}
+
+static void checkMalformed(const vector<uint32_t>& words) {
+    string text = referenceText(words, "\n");
+    const char badBytes[] = {'2', '/', ' ', 'a', '\0', '\r', static_cast<char>(0xB0)};
+    // Corrupt a line in the middle of a run and the last line
+    for (size_t line : {words.size() / 2, words.size() - 1}) {
+        for (size_t position = 0; position < 32; ++position) {
+            for (char bad : badBytes) {
+                string corrupt = text;
+                corrupt[line * BITSTRING_LINE_BYTES + position] = bad;
+                expectMalformed(corrupt, line + 1, "byte " + to_string(static_cast<uint8_t>(bad)) +
+                                " at line " + to_string(line + 1) + " column " + to_string(position + 1));
+            }
+        }
+    }
+    size_t line = words.size() / 2;
+    string shortLine = text;
+    shortLine.erase(line * BITSTRING_LINE_BYTES, 1);
+    expectMalformed(shortLine, line + 1, "31-character line");
+    string longLine = text;
+    longLine.insert(line * BITSTRING_LINE_BYTES, "0");
+    expectMalformed(longLine, line + 1, "33-character line");
+    expectMalformed(text + " # trailing\n", words.size() + 1, "text after the last line");
+}
+
+int main() {
+    const string codec = bitstringCodecName();
+    cout << "Bitstring codec: " << codec << '\n';
+    if (FORCED_CODEC != nullptr && codec != FORCED_CODEC) {
+        cout << "FAIL: expected the " << FORCED_CODEC << " codec\n";
+        return 1;
+    }
+
+    vector<uint32_t> words = {0, 0xFFFFFFFFu, 0x80000000u, 1, 0x55555555u, 0xAAAAAAAAu,
+                              0x0F0F0F0Fu, 0x12345678u};
+    uint64_t state = 1;
+    while (words.size() < 4096)
+        words.push_back(static_cast<uint32_t>(splitmix64(state)));
+    for (size_t count : {0, 1, 2, 3, 15, 16, 17, 31, 32, 33, 100, 4096})
+        checkRoundTrip(vector<uint32_t>(words.begin(), words.begin() + count));
+    checkMalformed(vector<uint32_t>(words.begin(), words.begin() + 100));
+
+    if (failures != 0)
+        return 1;
+    cout << "Codec check passed\n";
+    return 0;
+}
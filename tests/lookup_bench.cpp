@@ -0,0 +1,167 @@
+/*------------------------------------------------------------------------------
+  File:        tests/lookup_bench.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Times the packed-name switch lookups against hash map lookups.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Parses an assembly file, collects every mnemonic and register
+               operand in source order, then resolves them repeatedly with
+               lookupMnemonic/lookupRegister and with the
+               unordered_map<string, ...> tables the encoder used before.
+               The map side looks up std::string keys built up front, so
+               only the lookups are timed. Both sides must agree on every
+               name; the program exits non-zero if they do not.
+
+               Usage: lookup_bench <source.s> [rounds]
+               make bench runs it on a tiny_mips_gen mixed workload.
+
+  Dependencies:
+    - parser.h, arena.h, converters.h
+    - <iostream>, <fstream>, <sstream>, <string>, <vector>, <unordered_map>,
+      <chrono>, <cstdlib>
+  -----------------------------------------------------------------------------*/
+#include "../parser.h"
+#include "../arena.h"
+#include "../converters.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+// The tables lookupMnemonic and lookupRegister replaced
+static const unordered_map<string, Mnemonic> mnemonicMap = {
+    {"sll", Mnemonic::Sll}, {"srl", Mnemonic::Srl}, {"jr", Mnemonic::Jr},
+    {"mult", Mnemonic::Mult}, {"div", Mnemonic::Div}, {"add", Mnemonic::Add},
+    {"sub", Mnemonic::Sub}, {"and", Mnemonic::And}, {"or", Mnemonic::Or},
+    {"nor", Mnemonic::Nor}, {"slt", Mnemonic::Slt}, {"j", Mnemonic::J},
+    {"jal", Mnemonic::Jal}, {"beq", Mnemonic::Beq}, {"bne", Mnemonic::Bne},
+    {"addi", Mnemonic::Addi}, {"slti", Mnemonic::Slti}, {"andi", Mnemonic::Andi},
+    {"ori", Mnemonic::Ori}, {"xori", Mnemonic::Xori}, {"lb", Mnemonic::Lb},
+    {"lw", Mnemonic::Lw}, {"sb", Mnemonic::Sb}, {"sw", Mnemonic::Sw}
+};
+
+static const unordered_map<string, int> registerMap = {
+    {"$zero", 0}, {"$at", 1},
+    {"$v0", 2}, {"$v1", 3},
+    {"$a0", 4}, {"$a1", 5}, {"$a2", 6}, {"$a3", 7},
+    {"$t0", 8}, {"$t1", 9}, {"$t2", 10}, {"$t3", 11},
+    {"$t4", 12}, {"$t5", 13}, {"$t6", 14}, {"$t7", 15},
+    {"$s0", 16}, {"$s1", 17}, {"$s2", 18}, {"$s3", 19},
+    {"$s4", 20}, {"$s5", 21}, {"$s6", 22}, {"$s7", 23},
+    {"$t8", 24}, {"$t9", 25},
+    {"$k0", 26}, {"$k1", 27},
+    {"$gp", 28}, {"$sp", 29}, {"$fp", 30}, {"$ra", 31}
+};
+
+// Register of an operand: "$t0", or the base of "8($sp)"; empty otherwise
+static string_view registerOperand(string_view arg) {
+    size_t open = arg.find('(');
+    if (open != string_view::npos && arg.back() == ')')
+        return arg.substr(open + 1, arg.size() - open - 2);
+    return (!arg.empty() && arg[0] == '$') ? arg : string_view();
+}
+
+// Nanoseconds per lookup for rounds passes of body over count names
+template <typename Body>
+static double timeLookups(size_t count, unsigned rounds, Body body) {
+    auto start = chrono::steady_clock::now();
+    for (unsigned round = 0; round < rounds; ++round)
+        body();
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / (static_cast<double>(count) * rounds);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        cerr << "Usage: " << argv[0] << " <source.s> [rounds]\n";
+        return 1;
+    }
+    unsigned rounds = (argc == 3) ? static_cast<unsigned>(strtoul(argv[2], nullptr, 10)) : 20;
+    ifstream input(argv[1], ios::binary);
+    if (!input || rounds == 0) {
+        cerr << "Error: Cannot open input file: " << argv[1] << '\n';
+        return 1;
+    }
+    stringstream buffer;
+    buffer << input.rdbuf();
+    string source = buffer.str();
+
+    Arena arena;
+    LabelTable labels;
+    vector<TokenView> tokens = parseSource(source, arena, labels);
+    vector<string_view> ops;
+    vector<string_view> registers;
+    for (const TokenView& token : tokens) {
+        ops.push_back(token.op);
+        for (size_t i = 0; i < token.argCount; ++i) {
+            string_view reg = registerOperand(token.args[i]);
+            if (!reg.empty())
+                registers.push_back(reg);
+        }
+    }
+    vector<string> opKeys(ops.begin(), ops.end());
+    vector<string> registerKeys(registers.begin(), registers.end());
+
+    // Results are summed so the loops cannot be optimized away, and compared
+    volatile uint64_t sink = 0;
+    uint64_t switchSum = 0;
+    uint64_t mapSum = 0;
+    double switchMnemonic = timeLookups(ops.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (string_view op : ops)
+            sum += static_cast<uint64_t>(lookupMnemonic(op));
+        switchSum = sum;
+        sink = sink + sum;
+    });
+    double mapMnemonic = timeLookups(opKeys.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (const string& op : opKeys) {
+            auto it = mnemonicMap.find(op);
+            sum += static_cast<uint64_t>(it != mnemonicMap.end() ? it->second : Mnemonic::Unknown);
+        }
+        mapSum = sum;
+        sink = sink + sum;
+    });
+    if (switchSum != mapSum) {
+        cerr << "Error: mnemonic lookups disagree\n";
+        return 1;
+    }
+    double switchRegister = timeLookups(registers.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (string_view reg : registers)
+            sum += static_cast<uint64_t>(lookupRegister(reg));
+        switchSum = sum;
+        sink = sink + sum;
+    });
+    double mapRegister = timeLookups(registerKeys.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (const string& reg : registerKeys) {
+            auto it = registerMap.find(reg);
+            sum += static_cast<uint64_t>(it != registerMap.end() ? it->second : -1);
+        }
+        mapSum = sum;
+        sink = sink + sum;
+    });
+    if (switchSum != mapSum) {
+        cerr << "Error: register lookups disagree\n";
+        return 1;
+    }
+
+    cout << "Lookups over " << argv[1] << ", " << rounds << " round(s)\n"
+         << "  mnemonics (" << ops.size() << "): switch " << switchMnemonic << " ns, map "
+         << mapMnemonic << " ns\n"
+         << "  registers (" << registers.size() << "): switch " << switchRegister << " ns, map "
+         << mapRegister << " ns\n";
+    return 0;
+}
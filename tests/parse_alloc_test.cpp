@@ -0,0 +1,94 @@
+/*------------------------------------------------------------------------------
+  File:        tests/parse_alloc_test.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Checks that parseSource makes no heap allocation per line.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Parses generated sources of N and 10 * N lines with the
+               counting operator new from alloc_counter.cpp linked in:
+
+               - without labels, and with an arena block big enough for the
+                 longer source, both runs must allocate exactly as often
+               - with a label on every line, the longer run may only add
+                 the label table doublings (10x the labels is 4 of them)
+
+               Prints each count and exits non-zero on failure.
+
+  Dependencies:
+    - parser.h, arena.h, alloc_counter.h
+    - <iostream>, <string>, <cstdint>
+  -----------------------------------------------------------------------------*/
+#include "../parser.h"
+#include "../arena.h"
+#include "../alloc_counter.h"
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+static const size_t BASE_LINES = 10000;
+// Holds the operand arrays of 10 * BASE_LINES lines in one block
+static const size_t ARENA_BYTES = 16 * 1024 * 1024;
+static const uint64_t LABEL_TABLE_DOUBLINGS = 4;
+
+// One line of each instruction format, cycled; labeled lines get "Ln: "
+static string makeSource(size_t lines, bool labeled) {
+    static const char* const bodies[] = {
+        "add $t0, $t1, $t2", "addi $s0, $s0, -12", "lw $t3, 8($sp)",
+        "sw $t3, 0x10($a0)", "beq $t0, $zero, L0", "j L0", "slt $t4, $t0, $t1  # compare"};
+    string source;
+    for (size_t i = 0; i < lines; ++i) {
+        if (labeled)
+            source += "L" + to_string(i) + ": ";
+        source += bodies[i % (sizeof(bodies) / sizeof(bodies[0]))];
+        source += '\n';
+    }
+    return source;
+}
+
+// Heap allocations made by one parseSource call over source
+static uint64_t parseAllocations(const string& source, size_t arenaBytes, size_t& tokenCount) {
+    Arena arena(arenaBytes);
+    LabelTable labels;
+    uint64_t before = heapAllocationCount();
+    vector<TokenView> tokens = parseSource(source, arena, labels);
+    uint64_t allocations = heapAllocationCount() - before;
+    tokenCount = tokens.size();
+    return allocations;
+}
+
+// Parses N and 10 * N lines; growth is the most the longer run may add
+static bool checkGrowth(const char* name, bool labeled, size_t arenaBytes, uint64_t growth) {
+    string small = makeSource(BASE_LINES, labeled);
+    string large = makeSource(BASE_LINES * 10, labeled);
+    size_t smallTokens = 0;
+    size_t largeTokens = 0;
+    uint64_t smallAllocations = parseAllocations(small, arenaBytes, smallTokens);
+    uint64_t largeAllocations = parseAllocations(large, arenaBytes, largeTokens);
+    cout << name << ": " << smallAllocations << " allocation(s) for " << smallTokens << " line(s), "
+         << largeAllocations << " for " << largeTokens << '\n';
+    if (smallTokens != BASE_LINES || largeTokens != BASE_LINES * 10) {
+        cout << "FAIL: " << name << ": wrong token count\n";
+        return false;
+    }
+    if (largeAllocations > smallAllocations + growth) {
+        cout << "FAIL: " << name << ": allocations grow with the line count\n";
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    bool passed = checkGrowth("unlabeled", false, ARENA_BYTES, 0);
+    passed = checkGrowth("labeled", true, ARENA_BYTES, LABEL_TABLE_DOUBLINGS) && passed;
+    if (!passed)
+        return 1;
+    cout << "Parse allocation check passed\n";
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*------------------------------------------------------------------------------
+  File:        timing_model.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Builds the enabled performance models and prints their
+               reports.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - timing_model.h
+  -----------------------------------------------------------------------------*/
+#include "timing_model.h"
+
+using namespace std;
+
+TimingModel::TimingModel(const TimingConfig& config) {
+    if (config.pipelineEnabled)
+        pipeline.reset(new PipelineModel(config.pipeline));
+    if (config.instructionCacheEnabled)
+        instructionCache.reset(new CacheModel(config.instructionCache));
+    if (config.dataCacheEnabled)
+        dataCache.reset(new CacheModel(config.dataCache));
+    if (config.predictorEnabled)
+        predictor.reset(new BranchPredictor(config.predictor));
+    if (config.profileEnabled)
+        guestProfiler.reset(new Profiler());
+}
+
+void TimingModel::report(ostream& out) const {
+    if (instructionCache)
+        instructionCache->report(out, "I-cache");
+    if (dataCache)
+        dataCache->report(out, "D-cache");
+    if (predictor)
+        predictor->report(out);
+    if (pipeline)
+        pipeline->report(out);
+    if (guestProfiler)
+        guestProfiler->report(out);
+}
@@ -0,0 +1,106 @@
+/*------------------------------------------------------------------------------
+  File:        timing_model.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the set of performance models a TinyMipsCPU drives
+               while it runs a program.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               The functional engines stay untimed. When a TimingModel is
+               attached, the CPU passes it the RetireRecord of every
+               instruction (the same record the retire trace stores) and
+               the enabled models account for it in program order. With no
+               model attached the engines build no records at all.
+
+               The instruction cache sees the pc of every instruction and
+               the data cache the address of every lw and sw. When the
+               pipeline model is enabled too, their misses become fetch and
+               MEM stalls in it. The branch predictor sees every beq and
+               j; with the pipeline enabled only its mispredictions flush.
+               The profiler counts what the program spent its instructions
+               on.
+
+  Dependencies:
+    - retire_trace.h, pipeline_model.h, cache_model.h, branch_predictor.h, profiler.h
+    - <memory>, <ostream>
+  -----------------------------------------------------------------------------*/
+#ifndef TIMING_MODEL_H
+#define TIMING_MODEL_H
+
+#include <memory>
+#include <ostream>
+#include "retire_trace.h"
+#include "pipeline_model.h"
+#include "cache_model.h"
+#include "branch_predictor.h"
+#include "profiler.h"
+
+// Which models to build and their settings
+struct TimingConfig {
+    bool pipelineEnabled = false;
+    PipelineConfig pipeline;
+    bool instructionCacheEnabled = false;
+    CacheConfig instructionCache;
+    bool dataCacheEnabled = false;
+    CacheConfig dataCache;
+    bool predictorEnabled = false;
+    PredictorConfig predictor;
+    bool profileEnabled = false;
+
+    // True if any model is enabled
+    bool enabled() const {
+        return pipelineEnabled || instructionCacheEnabled || dataCacheEnabled || predictorEnabled ||
+               profileEnabled;
+    }
+};
+
+class TimingModel {
+public:
+    explicit TimingModel(const TimingConfig& config);
+
+    TimingModel(const TimingModel&) = delete;
+    TimingModel& operator=(const TimingModel&) = delete;
+
+    // Accounts for the next retired instruction in every enabled model
+    void retire(const RetireRecord& record) {
+        unsigned fetchStall = 0;
+        unsigned memoryStall = 0;
+        if (instructionCache && !instructionCache->access(record.pc, false))
+            fetchStall = instructionCache->config().missPenalty;
+        if (dataCache && (record.flags & (RETIRE_MEM_READ | RETIRE_MEM_WRITE))) {
+            bool write = (record.flags & RETIRE_MEM_WRITE) != 0;
+            if (!dataCache->access(record.memAddress, write))
+                memoryStall = dataCache->config().missPenalty;
+        }
+        PredictionOutcome prediction = PredictionOutcome::NotControl;
+        if (predictor)
+            prediction = predictor->resolve(record);
+        if (pipeline)
+            pipeline->retire(record, fetchStall, memoryStall, prediction);
+        if (guestProfiler)
+            guestProfiler->retire(record);
+    }
+
+    // Enabled models, nullptr otherwise
+    const PipelineModel* pipelineModel() const { return pipeline.get(); }
+    const CacheModel* instructionCacheModel() const { return instructionCache.get(); }
+    const CacheModel* dataCacheModel() const { return dataCache.get(); }
+    const BranchPredictor* branchPredictor() const { return predictor.get(); }
+    Profiler* profiler() { return guestProfiler.get(); }
+
+    // Prints the report of every enabled model
+    void report(std::ostream& out) const;
+
+private:
+    std::unique_ptr<PipelineModel> pipeline;
+    std::unique_ptr<CacheModel> instructionCache;
+    std::unique_ptr<CacheModel> dataCache;
+    std::unique_ptr<BranchPredictor> predictor;
+    std::unique_ptr<Profiler> guestProfiler;
+};
+
+#endif // TIMING_MODEL_H
@@ -0,0 +1,28 @@
+/*------------------------------------------------------------------------------
+  File:        tiny_mips.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     In-memory assembly entry point of the embedding library.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - tiny_mips.h, arena.h
+  -----------------------------------------------------------------------------*/
+#include "tiny_mips.h"
+#include "arena.h"
+
+using namespace std;
+
+vector<uint32_t> assembleSource(string_view source, unordered_map<string, uint32_t>* symbols) {
+    // Tokens point into source; operand arrays live in the arena
+    Arena arena;
+    LabelTable labels;
+    vector<TokenView> tokens = parseSource(source, arena, labels);
+    vector<uint32_t> words = assembleWords(tokens, labels);
+    if (symbols)
+        *symbols = labels.toMap();
+    return words;
+}
@@ -0,0 +1,58 @@
+/*------------------------------------------------------------------------------
+  File:        tiny_mips.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Single header for programs that embed the assembler and the
+               simulator through the libtinymips.a static library.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Source text goes in and instruction words come out, then
+               move straight into a CPU with no file or bitstring step:
+
+                   TraceSink sink(1, 256);
+                   TinyMipsCPU cpu;
+                   cpu.loadProgram(assembleSource(source));
+                   cpu.setTrace(TraceLevel::None, sink);
+                   cpu.executeProgram();
+
+               The lower-level steps are available too: parse() and
+               assembleWords() for a vector of lines (parser.h, encoder.h),
+               parseSource() and the TokenView assembleWords() for a whole
+               buffer. CPUs share no state, so any number can run on
+               different threads, each with its own TraceSink.
+
+  Dependencies:
+    - parser.h, encoder.h, tiny_mips_cpu.h, trace_sink.h
+    - <string>, <string_view>, <vector>, <unordered_map>, <cstdint>
+  -----------------------------------------------------------------------------*/
+#ifndef TINY_MIPS_H
+#define TINY_MIPS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "parser.h"
+#include "encoder.h"
+#include "tiny_mips_cpu.h"
+#include "trace_sink.h"
+
+/**
+ * Assembles a complete source buffer in memory, with the same rules as
+ * tiny_mips_asm.
+ *
+ * @param source  - Assembly source, lines separated by '\n'
+ * @param symbols - If not null, receives every label and its address
+ * @return Encoded instructions, one word per source instruction
+ * @throws std::runtime_error on malformed or unsupported instructions or
+ *         an undefined label
+ */
+std::vector<uint32_t> assembleSource(std::string_view source,
+                                     std::unordered_map<std::string, uint32_t>* symbols = nullptr);
+
+#endif // TINY_MIPS_H
@@ -14,7 +14,16 @@
     - parser.h: for parsing instructions and building the symbol table
     - encoder.h: for translating parsed instructions into machine code
     - converters.h: for converting functions
-    - <fstream>, <iostream>, <vector>, <string>, <unordered_map>, <cstdint>
+    - object_file.h: for the packed binary output mode
+    - stream_assembler.h: for the single-pass streaming mode
+    - alloc_counter.h: for the --stats allocation count
+    - parallel_assembler.h: for multi-threaded assembly (-j)
+    - source_scanner.h: for the memory-mapped input of the two-pass mode
+    - assembly_cache.h: for incremental re-assembly (-i)
+    - batch_assembler.h: for assembling many files per run (--batch)
+    - line_table.h: for the source line table (-g)
+    - bitstring_codec.h: for writing the bitstring text output
+    - <fstream>, <iostream>, <sstream>, <vector>, <string>, <unordered_map>, <cstdint>
   -----------------------------------------------------------------------------*/
 #include <iostream>
 #include <fstream>
@@ -22,59 +31,263 @@
 #include <string>
 #include <unordered_map>
 #include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
 
 #include "parser.h"
 #include "encoder.h" 
 #include "converters.h"
+#include "object_file.h"
+#include "stream_assembler.h"
+#include "alloc_counter.h"
+#include "parallel_assembler.h"
+#include "source_scanner.h"
+#include "assembly_cache.h"
+#include "batch_assembler.h"
+#include "line_table.h"
+#include "bitstring_codec.h"
 #include "tiny_mips_asm.h"  
 
 using namespace std;
 
+// Wall-clock time of each assembler phase, printed by --stats
+class PhaseTimer {
+public:
+    PhaseTimer() : last(chrono::steady_clock::now()) { }
+
+    // Ends the current phase and starts the next one
+    void mark(const char* phase) {
+        auto now = chrono::steady_clock::now();
+        phases.push_back({phase, chrono::duration<double, milli>(now - last).count()});
+        last = now;
+    }
+
+    void print(ostream& out) const {
+        double total = 0;
+        out << "Timing:";
+        for (const auto& phase : phases) {
+            out << ' ' << phase.first << ' ' << phase.second << " ms,";
+            total += phase.second;
+        }
+        out << " total " << total << " ms" << endl;
+    }
+
+private:
+    chrono::steady_clock::time_point last;
+    vector<pair<const char*, double>> phases;
+};
+
 /**
- * Runs the assembler using an input and output file path.
+ * Single-pass mode: encodes while reading and patches forward references in
+ * the output. A partially written output file is removed on error.
  *
- * @param inputFilePath - Path to the .s file containing MIPS assembly
- * @param outputFilePath - Path to output file where binary will be written
- * @return 0 if successful, 1 on error
+ * @return Number of instructions written
+ * @throws std::runtime_error on any assembly or I/O error
  */
-int runAssembler(const string& inputFilePath, const string& outputFilePath) {  
+static size_t runStreamingAssembler(const string& inputFilePath, const string& outputFilePath,
+                                    const AssemblerOptions& options, ostream& details) {
+    PhaseTimer timer;
     // Open the input assembly file from user 
     ifstream inputFile(inputFilePath);
     if (!inputFile) {
-        cerr << "Error: Cannot open input file: " << inputFilePath << endl;
-        return 1; 
+        throw runtime_error("Cannot open input file: " + inputFilePath);
     }
-    // Read the entire input file into a list of strings (line-by-line)
-    vector<string> sourceLines; 
-    string line; 
-  
-    while (getline(inputFile, line)) {
-        sourceLines.push_back(line);
+    unordered_map<string, uint32_t> symbolTable;
+    size_t count;
+    unique_ptr<WordSink> sink;
+    if (options.format == OutputFormat::Binary)
+        sink.reset(new ObjectWordSink(outputFilePath));
+    else
+        sink.reset(new TextWordSink(outputFilePath));
+    try {
+        count = assembleStream(inputFile, *sink, symbolTable);
+    } catch (...) {
+        sink.reset();
+        remove(outputFilePath.c_str());
+        throw;
     }
-    inputFile.close();
+    timer.mark("assemble");
+    if (options.stats)
+        timer.print(details);
+    return count;
+}
 
-    // Symbol table will store labels and address mappings
-    unordered_map<string, uint32_t> symbolTable; 
+/**
+ * Two-pass mode: parse the mapped source, encode, then write the output.
+ *
+ * @return Number of instructions written
+ * @throws std::runtime_error on any assembly or I/O error
+ */
+static size_t runTwoPassAssembler(const string& inputFilePath, const string& outputFilePath,
+                                  const AssemblerOptions& options, ostream& details) {
+    PhaseTimer timer;
+    // Map the entire input file - tokens point straight into the mapping
+    MappedSource input(inputFilePath);
+    string_view source = input.view();
+    timer.mark("map");
+
+    // Label table and operand lists live as long as this run
+    LabelTable labels;
+    Arena arena;
 
     // Instructions are tokenized and syumbol table created (Part of first pass) 
-    vector<Token> tokens = parse(sourceLines, symbolTable);
+    uint64_t allocationsBefore = heapAllocationCount();
+    vector<TokenView> tokens;
+    vector<SourceChunk> chunks;
+    if (options.threads > 1)
+        chunks = parseParallel(source, options.threads, labels);
+    else
+        tokens = parseSource(source, arena, labels);
+    uint64_t parseAllocations = heapAllocationCount() - allocationsBefore;
+    timer.mark("parse");
+
+    // Encode parsed instructions into 32-bit machine words (Part of second pass)
+    vector<uint32_t> machineWords;
+    // Incremental mode: line hashes saved for the next run, and the cache
+    // sitting next to the output
+    vector<uint64_t> lineHashes;
+    string cachePath = outputFilePath + ".cache";
+    bool cacheLoaded = false;
+    size_t reused = 0;
+    if (options.incremental) {
+        AssemblyCache cache;
+        cacheLoaded = cache.load(cachePath);
+        size_t total = tokens.size();
+        for (const SourceChunk& chunk : chunks)
+            total += chunk.tokens.size();
+        machineWords.reserve(total);
+        lineHashes.reserve(total);
+        if (options.threads > 1) {
+            for (const SourceChunk& chunk : chunks)
+                reused += cache.assemble(chunk.tokens, chunk.basePc, labels, machineWords, lineHashes);
+        } else {
+            reused = cache.assemble(tokens, 0, labels, machineWords, lineHashes);
+        }
+    } else if (options.threads > 1) {
+        machineWords = encodeParallel(chunks, labels, options.threads);
+    } else {
+        machineWords = assembleWords(tokens, labels);
+    }
+    timer.mark("encode");
+
+    if (options.format == OutputFormat::Binary) {
+        // Packed object file: header, raw words and the symbol table
+        writeObjectFile(outputFilePath, machineWords, labels.toMap());
+    } else {
+        // Format the whole program into one buffer, then write it at once
+        string text = options.threads > 1 ? formatWordsParallel(machineWords, options.threads)
+                                          : formatBitstrings(machineWords);
+        ofstream outputFile(outputFilePath, ios::binary); 
+        if (!outputFile) { 
+            throw runtime_error("Cannot open output file: " + outputFilePath);
+        } 
+        outputFile.write(text.data(), static_cast<streamsize>(text.size()));
+        outputFile.close();
+        if (!outputFile) {
+            throw runtime_error("Failed writing output file: " + outputFilePath);
+        }
+    }
+    if (options.incremental)
+        AssemblyCache::save(cachePath, lineHashes, machineWords, labels);
+    timer.mark("write");
 
-    // Encode parsed instructions into 32-bit binary strings (Part of second pass)
-    vector<string> binaryOutput = assemble(tokens, symbolTable); 
+    if (options.incremental) {
+        if (cacheLoaded)
+            details << "Reused " << reused << " of " << machineWords.size() << " instruction(s) from " << cachePath << endl;
+        else
+            details << "No usable cache at " << cachePath << "; encoded every instruction" << endl;
+    }
+    if (options.stats) {
+        timer.print(details);
+        details << "Scanner: " << scannerName() << endl;
+        if (options.format != OutputFormat::Binary)
+            details << "Bitstring codec: " << bitstringCodecName() << endl;
+        details << "Heap allocations: " << parseAllocations << " while parsing " << machineWords.size()
+                << " instruction(s), " << heapAllocationCount() << " in total" << endl;
+    }
+    return machineWords.size();
+}
 
-    // Open the output file for writing the encoded machine code
-    ofstream outputFile(outputFilePath); 
-    if (!outputFile) { 
-        cerr << "Error: Cannot open output file: " << outputFilePath << endl;
+/**
+ * Writes the line table of a source file that assembled successfully. The
+ * source is read again with parseLine, so the table is the same whichever
+ * mode produced the output.
+ *
+ * @throws std::runtime_error if either file cannot be opened
+ */
+static void writeSourceLineTable(const string& inputFilePath, const string& tablePath) {
+    ifstream inputFile(inputFilePath);
+    if (!inputFile) {
+        throw runtime_error("Cannot open input file: " + inputFilePath);
+    }
+    LineTable table;
+    table.sourcePath = inputFilePath;
+    string rawLine;
+    SourceLine parsed;
+    uint32_t pc = 0;
+    uint32_t lineNumber = 0;
+    while (getline(inputFile, rawLine)) {
+        ++lineNumber;
+        parseLine(rawLine, parsed);
+        // A label names the next instruction, as in the symbol table
+        if (parsed.hasLabel && !parsed.label.empty())
+            table.labels.push_back({pc, parsed.label});
+        if (!parsed.hasInstruction)
+            continue;
+        string text = parsed.token.op;
+        for (size_t i = 0; i < parsed.token.args.size(); ++i)
+            text += (i == 0 ? " " : ", ") + parsed.token.args[i];
+        table.lines.push_back({pc, lineNumber, text});
+        pc += 4;
+    }
+    writeLineTable(tablePath, table);
+}
+
+AssemblyResult assembleFile(const string& inputFilePath, const string& outputFilePath,
+                            const AssemblerOptions& options) {
+    AssemblyResult result;
+    ostringstream details;
+    try {
+        result.instructions = options.streaming
+            ? runStreamingAssembler(inputFilePath, outputFilePath, options, details)
+            : runTwoPassAssembler(inputFilePath, outputFilePath, options, details);
+        if (options.lineTable)
+            writeSourceLineTable(inputFilePath, outputFilePath + ".lines");
+        result.ok = true;
+        result.details = details.str();
+    } catch (const exception& e) {
+        result.error = e.what();
+        // Some encoder messages end in a newline
+        while (!result.error.empty() && result.error.back() == '\n')
+            result.error.pop_back();
+    }
+    return result;
+}
+
+/**
+ * Runs the assembler using an input and output file path.
+ *
+ * @param inputFilePath - Path to the .s file containing MIPS assembly
+ * @param outputFilePath - Path to output file where binary will be written
+ * @param options - Output format and assembly mode
+ * @return 0 if successful, 1 on error
+ */
+int runAssembler(const string& inputFilePath, const string& outputFilePath,
+                 const AssemblerOptions& options) {  
+    AssemblyResult result = assembleFile(inputFilePath, outputFilePath, options);
+    if (!result.ok) {
+        cerr << "Error: " << result.error << endl;
         return 1;
-    } 
-    // Write each encoded binary instruction to the output file
-    for (const auto& binary : binaryOutput) {
-        outputFile << binary << '\n';
-    } 
-    outputFile.close();
+    }
     // Display confirmation message to user
-    cout << "Assembled " << binaryOutput.size() << " instruction(s) to " << outputFilePath << endl;  
+    cout << "Assembled " << result.instructions << " instruction(s) to " << outputFilePath << endl;  
+    cout << result.details;
     return 0;
 } 
 
@@ -82,14 +295,69 @@ int runAssembler(const string& inputFilePath, const string& outputFilePath) {
  * Main function: handles command-line arguments and runs the assembler.
  *
  * Usage:
- *   ./tiny_mips_asm input.s output.txt 
+ *   ./tiny_mips_asm [-b] [-s] input.s output.txt 
+ *   ./tiny_mips_asm --batch [-b] [-j N] inputs... 
+ *
+ *   -b, --binary   Write a packed binary object file instead of bitstrings
+ *   -s, --stream   Single-pass assembly with forward-reference fixups
+ *   -j N           Parse, encode and format on N threads (two-pass mode);
+ *                  in batch mode, the number of files assembled at once
+ *   -i, --incremental  Re-encode only lines changed since the last run
+ *   --stats        Print the time spent in each phase
+ *   -g, --line-table   Also write OUTPUT.lines for the simulator's profiler
+ *   --batch        Assemble every input (paths, globs or @manifest files)
+ *                  into a .txt/.obj file beside it
  */
 int main(int argc, char* argv[])  {
-    // Check that the correct num of args are used
-    if (argc != 3)  {
-        cerr << "Usage: tiny_mips_asm <input_file.s> <output_file.txt>\n"; 
+    AssemblerOptions options;
+    vector<string> paths;
+    bool batch = false;
+    bool threadsGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-b" || arg == "--binary") {
+            options.format = OutputFormat::Binary;
+        } else if (arg == "-s" || arg == "--stream") {
+            options.streaming = true;
+        } else if (arg == "-i" || arg == "--incremental") {
+            options.incremental = true;
+        } else if (arg == "--stats") {
+            options.stats = true;
+        } else if (arg == "-g" || arg == "--line-table") {
+            options.lineTable = true;
+        } else if (arg == "--batch") {
+            batch = true;
+        } else if (arg.rfind("-j", 0) == 0) {
+            // Accepts "-j N" and "-jN"
+            string count = arg.substr(2);
+            if (count.empty() && i + 1 < argc)
+                count = argv[++i];
+            options.threads = static_cast<unsigned>(strtoul(count.c_str(), nullptr, 10));
+            threadsGiven = true;
+            if (options.threads == 0) {
+                cerr << "Error: -j needs a thread count of at least 1\n";
+                return 1;
+            }
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    // Check that the correct num of args are used (streaming is single-threaded
+    // and keeps no cache; in batch mode -j sizes the pool instead)
+    bool badStreaming = options.streaming && (options.incremental || (!batch && options.threads > 1));
+    if ((batch ? paths.empty() : paths.size() != 2) || badStreaming)  {
+        cerr << "Usage: tiny_mips_asm [-b|--binary] [-s|--stream] [-j N] [-i|--incremental] [-g|--line-table] [--stats] <input_file.s> <output_file>\n"
+                "       tiny_mips_asm --batch [-b|--binary] [-s|--stream] [-j N] [-i|--incremental] [-g|--line-table] <input.s|pattern|@manifest>...\n"; 
         return 1;
     } 
+    if (batch) {
+        // One pool thread per core unless -j says otherwise
+        if (!threadsGiven)
+            options.threads = max(1u, thread::hardware_concurrency());
+        return runBatchAssembler(paths, options);
+    }
     // Exec assembler with input and output file paths
-    return runAssembler(argv[1], argv[2]); 
+    return runAssembler(paths[0], paths[1], options); 
 }
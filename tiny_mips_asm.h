@@ -15,7 +15,64 @@
 #ifndef TINY_MIPS_ASM_H
 #define TINY_MIPS_ASM_H
 
-int runAssembler(const std::string& inputFilePath, const std::string& outputFilePath);
+#include <string>
+
+// Output file layouts the assembler can produce
+enum class OutputFormat {
+    // One 32-character bitstring per line
+    Text,
+    // Packed binary object file (see object_file.h)
+    Binary
+};
+
+// Command line settings for one assembler run
+struct AssemblerOptions {
+    OutputFormat format = OutputFormat::Text;
+    // Single pass with forward-reference fixups (see stream_assembler.h)
+    bool streaming = false;
+    // Print per-phase timings after assembling
+    bool stats = false;
+    // Worker threads for the two-pass path (see parallel_assembler.h)
+    unsigned threads = 1;
+    // Reuse words from the previous run's sidecar cache (see assembly_cache.h)
+    bool incremental = false;
+    // Write OUTPUT.lines for the simulator's profiler (see line_table.h)
+    bool lineTable = false;
+};
+
+// Outcome of assembling one file. Filled in instead of printing, so any
+// number of files can be assembled at the same time.
+struct AssemblyResult {
+    // False if the file could not be assembled
+    bool ok = false;
+    // Why it failed (no "Error: " prefix)
+    std::string error;
+    // Instructions written to the output
+    size_t instructions = 0;
+    // Lines to print after the "Assembled" message (-i and --stats)
+    std::string details;
+};
+
+/**
+ * Assembles one file without printing anything. Safe to call from several
+ * threads at once: every exception, including a malformed or unsupported
+ * instruction, is caught and returned in the result.
+ *
+ * @param inputFilePath  - Path to the .s file containing MIPS assembly
+ * @param outputFilePath - Path of the output file
+ * @param options        - Output format and assembly mode
+ * @return Status, instruction count and report text
+ */
+AssemblyResult assembleFile(const std::string& inputFilePath, const std::string& outputFilePath,
+                            const AssemblerOptions& options = AssemblerOptions());
+
+/**
+ * Assembles one file and prints the result (errors to stderr).
+ *
+ * @return 0 if successful, 1 on error
+ */
+int runAssembler(const std::string& inputFilePath, const std::string& outputFilePath,
+                 const AssemblerOptions& options = AssemblerOptions());
 
 
 #endif // TINY_MIPS_ASM_H
\ No newline at end of file
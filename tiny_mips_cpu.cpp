@@ -10,128 +10,499 @@
 ------------------------------------------------------------------------------*/
 
 #include "tiny_mips_cpu.h"
+#include "tiny_mips_jit.h"
+#include "disassembler.h"
 #include <iostream>
 #include <bitset>
 #include <iomanip>
-#include <unordered_map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
 
 using namespace std;
 
-// Default flag for debugging
-bool DEBUG_MODE = false;
-
 /*  
  *  Class init - Set registers, PC to 0 and 
- *  Init 1024 x 4 bytes = 4096 bytes = 4KB
+ *  start with no data memory pages (allocated on first store)
 */
 TinyMipsCPU::TinyMipsCPU() 
-    : pc(0), registers{}, memory(1024, 0) { }
+    : engine(ExecEngine::Step), traceLevel(TraceLevel::Full),
+      trace(&TraceSink::standardOutput()), retireTrace(nullptr), timing(nullptr), maxSteps(0), steps(0),
+      debugMode(false), pc(0), registers{}, fusionEnabled(true), fusedPairs(0), jitWarned(false) { }
 
-// Use to catch infinite loops from bad test code
-int maxSteps = 0;
-int steps = 0;
+// Out of line so the header only needs a forward declaration of TinyMipsJit
+TinyMipsCPU::~TinyMipsCPU() = default;
 
 // Display func declaration
-void displayBits(uint32_t value, int bits);
+void displayBits(ostream& out, uint32_t value, int bits);
 
 // Need a function to load the instructions into the cpu class
 void TinyMipsCPU::loadProgram(const vector<uint32_t>& instructions) {
-    instructionMemory = instructions;
+    loadProgram(instructions.data(), instructions.size());
+}
+
+// Single copy from a raw word buffer - no per-instruction parsing
+void TinyMipsCPU::loadProgram(const uint32_t* words, size_t count) {
+    instructionMemory.assign(words, words + count);
+    prepareLoadedProgram();
+}
+
+// No copy at all - the vector's buffer becomes instruction memory
+void TinyMipsCPU::loadProgram(vector<uint32_t>&& instructions) {
+    instructionMemory = move(instructions);
+    prepareLoadedProgram();
+}
+
+void TinyMipsCPU::prepareLoadedProgram() {
+    // Decode every word once so the step loop never re-extracts fields
+    size_t count = instructionMemory.size();
+    decodedProgram.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        decodedProgram[i] = decodeInstruction(instructionMemory[i], static_cast<uint32_t>(i * 4));
+    }
+    // A pair starts at every word whose successor it fuses with; the
+    // second word keeps its own handler for jumps that land on it
+    fusedProgram.assign(count, FusedPair::None);
+    for (size_t i = 0; i + 1 < count; ++i) {
+        fusedProgram[i] = fusePair(decodedProgram[i], decodedProgram[i + 1]);
+    }
+    buildThreadedProgram();
+
     maxSteps = instructionMemory.size();
+    steps = 0;
+    fusedPairs = 0;
     pc = 0;
+    // Compiled blocks belong to the previous program
+    jit.reset();
+    jitWarned = false;
+}
+
+void TinyMipsCPU::setTrace(TraceLevel level, TraceSink& sink) {
+    traceLevel = level;
+    trace = &sink;
+}
+
+void TinyMipsCPU::setFusion(bool enabled) {
+    fusionEnabled = enabled;
+    buildThreadedProgram();
+}
+
+void TinyMipsCPU::setMaxSteps(uint64_t limit) {
+    maxSteps = limit;
+}
+
+uint64_t TinyMipsCPU::stepsExecuted() const {
+    return steps;
+}
+
+void TinyMipsCPU::loadMemoryImage(const uint8_t* bytes, size_t size) {
+    if (uint64_t(size) > (uint64_t(1) << 32)) {
+        throw runtime_error("Memory image of " + to_string(size)
+                            + " bytes exceeds the 32-bit address space");
+    }
+    memory.write(0, bytes, size);
+}
+
+uint64_t TinyMipsCPU::programHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    // Least significant byte first, as in stateHash
+    for (uint32_t word : instructionMemory) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash ^= (word >> shift) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+uint64_t TinyMipsCPU::stateHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const uint8_t* bytes, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    // Words are mixed least significant byte first on every host
+    auto mixWord = [&mix](uint32_t word) {
+        uint8_t bytes[4] = {uint8_t(word), uint8_t(word >> 8), uint8_t(word >> 16), uint8_t(word >> 24)};
+        mix(bytes, sizeof(bytes));
+    };
+    mixWord(pc);
+    for (uint32_t value : registers)
+        mixWord(value);
+    // Pages holding only zeros read the same as unallocated ones, so they
+    // are left out and the hash does not depend on which pages exist
+    memory.forEachPage([&](uint32_t pageNumber, const uint8_t* page) {
+        if (all_of(page, page + PagedMemory::PAGE_SIZE, [](uint8_t b) { return b == 0; }))
+            return;
+        mixWord(pageNumber);
+        mix(page, PagedMemory::PAGE_SIZE);
+    });
+    return hash;
+}
+
+string TinyMipsCPU::describeStateDifference(const TinyMipsCPU& other) const {
+    ostringstream out;
+    if (pc != other.pc) {
+        out << "pc: " << pc << " vs " << other.pc;
+        return out.str();
+    }
+    for (int i = 0; i < 32; ++i) {
+        if (registers[i] != other.registers[i]) {
+            out << registerName(i) << ": " << registers[i] << " vs " << other.registers[i];
+            return out.str();
+        }
+    }
+    // Every page either side allocated, in address order; a page the other
+    // side never touched reads as zeros
+    vector<uint32_t> pageNumbers;
+    auto collect = [&pageNumbers](uint32_t pageNumber, const uint8_t*) { pageNumbers.push_back(pageNumber); };
+    memory.forEachPage(collect);
+    other.memory.forEachPage(collect);
+    sort(pageNumbers.begin(), pageNumbers.end());
+    pageNumbers.erase(unique(pageNumbers.begin(), pageNumbers.end()), pageNumbers.end());
+    for (uint32_t pageNumber : pageNumbers) {
+        const uint8_t* mine = memory.findPage(pageNumber);
+        const uint8_t* theirs = other.memory.findPage(pageNumber);
+        for (uint32_t offset = 0; offset < PagedMemory::PAGE_SIZE; ++offset) {
+            int a = mine ? mine[offset] : 0;
+            int b = theirs ? theirs[offset] : 0;
+            if (a != b) {
+                out << "memory byte " << ((pageNumber << PagedMemory::PAGE_BITS) | offset)
+                    << ": " << a << " vs " << b;
+                return out.str();
+            }
+        }
+    }
+    return "";
 }
 
 // Will cycle through each instruction step until completion
 void TinyMipsCPU::executeProgram() {
+    executeUntil(numeric_limits<uint64_t>::max());
+}
+
+bool TinyMipsCPU::executeUntil(uint64_t stepCount) {
+    if (engine != ExecEngine::Step)
+        return executeFast(stepCount);
     // Heartbeat loop for each step
-    while(performStep()) {
+    while (steps < stepCount) {
+        if (!performStep())
+            return false;
         if (++steps > maxSteps) {
+            trace->flush();
             cerr << "[ERROR] Max instruction count exceeded. Possible infinite loop." << endl;
-            break;
+            return false;
         }
     }
+    return true;
+}
+
+// Runs a fast engine with the same step limit as the performStep loop
+bool TinyMipsCPU::executeFast(uint64_t stepCount) {
+    // The JIT is built on first use and kept until the next loadProgram;
+    // each fallback is reported once per program
+    TinyMipsJit* compiler = nullptr;
+    if (engine == ExecEngine::Jit && (retireTrace || timing)) {
+        if (!jitWarned) {
+            trace->flush();
+            cerr << "[WARNING] JIT does not " << (retireTrace ? "record retire traces" : "drive timing models")
+                 << ", using threaded interpreter" << endl;
+            jitWarned = true;
+        }
+    } else if (engine == ExecEngine::Jit) {
+        if (!jit && !jitWarned) {
+            jit.reset(new TinyMipsJit(*this));
+            if (!jit->available()) {
+                trace->flush();
+                cerr << "[WARNING] JIT not available on this host, using threaded interpreter" << endl;
+                jitWarned = true;
+                jit.reset();
+            }
+        }
+        compiler = jit.get();
+    }
+
+    while (steps < stepCount) {
+        // The step loop lets maxSteps + 1 instructions retire before stopping;
+        // with no room for the + 1 the budget simply stays at its maximum
+        uint64_t budget = (steps <= maxSteps) ? maxSteps - steps : 0;
+        if (budget != UINT64_MAX)
+            ++budget;
+        bool pausing = stepCount - steps < budget;
+        if (pausing)
+            budget = stepCount - steps;
+        RunResult result = compiler ? compiler->run(budget) : runThreaded(budget);
+        steps += result.retired;
+
+        if (result.reason == StopReason::Halt)
+            return false;
+        if (result.reason == StopReason::Budget) {
+            if (pausing)
+                return true;
+            trace->flush();
+            cerr << "[ERROR] Max instruction count exceeded. Possible infinite loop." << endl;
+            return false;
+        }
+        // Fault - let performStep execute and report the unsupported instruction
+        if (!performStep())
+            return false;
+        if (++steps > maxSteps) {
+            trace->flush();
+            cerr << "[ERROR] Max instruction count exceeded. Possible infinite loop." << endl;
+            return false;
+        }
+    }
+    return true;
 }
 
 // Works through the instruction | picks type | segments
 bool TinyMipsCPU::performStep() {
-    if (DEBUG_MODE) {
-        cout << "----- Instruction Iteration ------ " << endl;
+    // Untraced and one-line levels skip all of the formatting below
+    if (traceLevel != TraceLevel::Full && !debugMode) {
+        if (pc >= instructionMemory.size() * 4)
+            return false;
+
+        const DecodedOp& op = decodedProgram[pc / 4];
+        uint32_t instrPc = pc;
+        StepEffect effect;
+        bool redirected = executeOp(op, effect);
+        if (retireTrace || timing || traceLevel == TraceLevel::Changed) {
+            RetireRecord record = makeRetireRecord(instrPc, effect);
+            if (retireTrace)
+                retireTrace->append(record);
+            if (timing)
+                timing->retire(record);
+            if (traceLevel == TraceLevel::Changed)
+                trace->out() << formatRetireRecord(record) << '\n';
+        }
+
+        if (!redirected)
+            pc += 4;
+        return true;
+    }
+
+    ostream& out = trace->out();
+    if (debugMode) {
+        out << "----- Instruction Iteration ------ " << '\n';
     }
     // Reject badly formed instructions - not div by 4
     if (pc >= instructionMemory.size() * 4)
         return false;
 
-    // Get the current instruction from pc
+    // Get the current instruction from pc - fields were decoded at load time
     uint32_t current_instruction = instructionMemory[pc / 4];
+    const DecodedOp& op = decodedProgram[pc / 4];
     // Extract opcode from first 6 bit
     uint32_t opcode = getOpcode(current_instruction);
 
-    if (DEBUG_MODE) {
-        cout << "Getting Opcode " << endl;
-        displayBits(opcode, 6);
+    if (debugMode) {
+        out << "Getting Opcode " << '\n';
+        displayBits(out, opcode, 6);
     }
 
     // Initial iteration output display
-    cout << "\n=== Executing Instruction ===\n";
-    cout << "Binary: " << bitset<32>(current_instruction) << "\n";
-    cout << "Opcode: " << opcode << "\n";
+    out << "\n=== Executing Instruction ===\n";
+    out << "Binary: " << bitset<32>(current_instruction) << "\n";
+    out << "Opcode: " << opcode << "\n";
+
+    // Source operands as they were before the step, for the retire trace
+    uint32_t instrPc = pc;
+    uint32_t rsValue = registers[op.rs];
+    uint32_t rtValue = registers[op.rt];
 
     // Separate 0 for R-Type | 2, 3 for J-Type | Remaining are I-Type
-    if (opcode == 0) {
-        cout << "R-Type" << " Instruction\n\n";
-        runStyleRType(current_instruction); 
+    bool redirected;
+    if (op.handler <= OpHandler::UnknownR) {
+        out << "R-Type" << " Instruction\n\n";
+        redirected = runStyleRType(op, current_instruction); 
 
-    } else if (opcode == 2 || opcode == 3) {
-        cout << "J-Type" << " Instruction\n\n";
-        runStyleJType(current_instruction); 
+    } else if (op.handler == OpHandler::J) {
+        out << "J-Type" << " Instruction\n\n";
+        redirected = runStyleJType(op, current_instruction); 
 
     } else {
-        cout << "I-Type" << " Instruction\n\n";
-        runStyleIType(current_instruction, opcode);
+        out << "I-Type" << " Instruction\n\n";
+        redirected = runStyleIType(op, current_instruction);
     }
 
     // Show post-state summary
     displayRegisters();
-    cout << endl;
+    out << '\n';
     displayMemory(0, 64); 
 
-    // Increment pc + 4
-    pc += 4;
+    if (retireTrace || timing) {
+        RetireRecord record = makeRetireRecord(instrPc, effectOfStep(op, rsValue, rtValue, redirected));
+        if (retireTrace)
+            retireTrace->append(record);
+        if (timing)
+            timing->retire(record);
+    }
+
+    // Increment pc + 4 unless a taken beq or j already set it
+    if (!redirected)
+        pc += 4;
     return true;
 }
 
+// Executes one decoded op without formatting anything
+bool TinyMipsCPU::executeOp(const DecodedOp& op, StepEffect& effect) {
+    uint32_t rsValue = registers[op.rs];
+    uint32_t rtValue = registers[op.rt];
+    uint32_t result;
+
+    switch (op.handler) {
+        case OpHandler::Add: result = rsValue + rtValue; break;
+        case OpHandler::Sub: result = rsValue - rtValue; break;
+        case OpHandler::And: result = rsValue & rtValue; break;
+        case OpHandler::Or:  result = rsValue | rtValue; break;
+        case OpHandler::Nor: result = ~(rsValue | rtValue); break;
+        case OpHandler::Slt: result = static_cast<int32_t>(rsValue) < static_cast<int32_t>(rtValue); break;
+
+        case OpHandler::Addi:
+            registers[op.rt] = rsValue + static_cast<uint32_t>(op.imm);
+            effect.destReg = op.rt;
+            effect.destValue = registers[op.rt];
+            return false;
+
+        case OpHandler::Lw:
+            effect.memRead = true;
+            effect.memAddress = rsValue + static_cast<uint32_t>(op.imm);
+            effect.memValue = memory.loadWord(effect.memAddress);
+            registers[op.rt] = effect.memValue;
+            effect.destReg = op.rt;
+            effect.destValue = effect.memValue;
+            return false;
+
+        case OpHandler::Sw:
+            effect.memWrite = true;
+            effect.memAddress = rsValue + static_cast<uint32_t>(op.imm);
+            effect.memValue = rtValue;
+            memory.storeWord(effect.memAddress, rtValue);
+            return false;
+
+        case OpHandler::Beq:
+            if (rsValue != rtValue)
+                return false;
+            effect.branchTaken = true;
+            pc = op.target;
+            return true;
+
+        case OpHandler::J:
+            effect.branchTaken = true;
+            pc = op.target;
+            return true;
+
+        case OpHandler::UnknownR:
+            trace->flush();
+            cerr << "Unknown R-type funct: " << getFunct(instructionMemory[pc / 4]) << "\n";
+            return false;
+
+        default:
+            trace->flush();
+            cerr << "Unknown I-type opcode: " << getOpcode(instructionMemory[pc / 4]) << '\n';
+            return false;
+    }
+
+    // R-type results
+    registers[op.rd] = result;
+    effect.destReg = op.rd;
+    effect.destValue = result;
+    return false;
+}
+
+// Rebuilds what a runStyle* step changed so the full trace can be recorded too
+StepEffect TinyMipsCPU::effectOfStep(const DecodedOp& op, uint32_t rsValue, uint32_t rtValue,
+                                     bool redirected) const {
+    StepEffect effect;
+    switch (op.handler) {
+        case OpHandler::Add:
+        case OpHandler::Sub:
+        case OpHandler::And:
+        case OpHandler::Or:
+        case OpHandler::Nor:
+        case OpHandler::Slt:
+            effect.destReg = op.rd;
+            effect.destValue = registers[op.rd];
+            break;
+        case OpHandler::Addi:
+            effect.destReg = op.rt;
+            effect.destValue = registers[op.rt];
+            break;
+        case OpHandler::Lw:
+            effect.memRead = true;
+            effect.memAddress = rsValue + static_cast<uint32_t>(op.imm);
+            effect.memValue = registers[op.rt];
+            effect.destReg = op.rt;
+            effect.destValue = registers[op.rt];
+            break;
+        case OpHandler::Sw:
+            effect.memWrite = true;
+            effect.memAddress = rsValue + static_cast<uint32_t>(op.imm);
+            effect.memValue = rtValue;
+            break;
+        case OpHandler::Beq:
+        case OpHandler::J:
+            effect.branchTaken = redirected;
+            break;
+        default:
+            break;
+    }
+    return effect;
+}
+
+RetireRecord TinyMipsCPU::makeRetireRecord(uint32_t instrPc, const StepEffect& effect) const {
+    RetireRecord record{};
+    record.pc = instrPc;
+    record.instruction = instructionMemory[instrPc / 4];
+    record.destReg = effect.destReg >= 0 ? static_cast<uint8_t>(effect.destReg) : RETIRE_NO_DEST;
+    record.destValue = effect.destValue;
+    record.memAddress = effect.memAddress;
+    record.memValue = effect.memValue;
+    record.flags = (effect.memRead ? RETIRE_MEM_READ : 0)
+                 | (effect.memWrite ? RETIRE_MEM_WRITE : 0)
+                 | (effect.branchTaken ? RETIRE_BRANCH_TAKEN : 0);
+    return record;
+}
+
 void TinyMipsCPU::displayRegisters1(const std::unordered_set<int>& changedRegs) const {
+    ostream& out = trace->out();
     for (int i : changedRegs) {
-        cout << registerName(i) << ": 0x" << hex << setw(8) << setfill('0') << registers[i] << endl;
+        out << registerName(i) << ": 0x" << hex << setw(8) << setfill('0') << registers[i] << '\n';
     }
 }
 
 void TinyMipsCPU::displayRegisters() const {
+    ostream& out = trace->out();
     for (int i = 0; i < 32; ++i) {
-        cout << "R" << setw(2) << setfill('0') << i << ": " << setw(10) << registers[i];
+        out << "R" << setw(2) << setfill('0') << i << ": " << setw(10) << registers[i];
 
         if (i % 4 == 3) 
-            cout << '\n';
+            out << '\n';
         else 
-            cout << '\t';
+            out << '\t';
     }
 }
 
 // Displays memory that has contents
 void TinyMipsCPU::displayMemory(uint32_t start, uint32_t end) const {
-    cout << "\nMemory Contents (" << start << " to " << end << "):" << endl;
+    ostream& out = trace->out();
+    out << "\nMemory Contents (" << start << " to " << end << "):" << '\n';
 
     bool any = false;
     for (uint32_t addr = start; addr <= end; addr += 4) {
         uint32_t val = loadWord(addr);
         if (val != 0) {
-            cout << "M[" << setw(3) << addr << "] = " << hex << "0x" << val << dec << " (" << val << ")" << endl;
+            out << "M[" << setw(3) << addr << "] = " << hex << "0x" << val << dec << " (" << val << ")" << '\n';
             any = true;
         }
     }
 
     if (!any)
-        cout << "[No non-zero memory in this range]" << endl;
+        out << "[No non-zero memory in this range]" << '\n';
 }
 
 // Debugging Version - Shows zero values
@@ -147,240 +518,240 @@ void TinyMipsCPU::displayMemory(uint32_t start, uint32_t end) const {
 | 31-26 | 25-21 | 20-16 | 15-11 | 10-6  | 5-0 |
 |opcode |  rs   |  rt   |  rd   | shamt |funct|
 */
-void TinyMipsCPU::runStyleRType(uint32_t instruction) {
-    uint32_t rs = getRs(instruction);
-    uint32_t rt = getRt(instruction);
-    uint32_t rd = getRd(instruction);
-    uint32_t shamt = getShamt(instruction);
-    uint32_t funct = getFunct(instruction);
-
-    if (DEBUG_MODE) {
-        cout << "**> Starting R-Type instruction " << endl;
-        displayBits(rs, 5);
-        displayBits(rt, 5);
-        displayBits(rd, 5);
-        displayBits(shamt, 5);
-        displayBits(funct, 6);
+bool TinyMipsCPU::runStyleRType(const DecodedOp& op, uint32_t instruction) {
+    ostream& out = trace->out();
+    uint32_t rs = op.rs;
+    uint32_t rt = op.rt;
+    uint32_t rd = op.rd;
+
+    if (debugMode) {
+        out << "**> Starting R-Type instruction " << '\n';
+        displayBits(out, rs, 5);
+        displayBits(out, rt, 5);
+        displayBits(out, rd, 5);
+        displayBits(out, getShamt(instruction), 5);
+        displayBits(out, getFunct(instruction), 6);
     }
 
-    switch (funct) {
+    switch (op.handler) {
         // Add - Function Code 32
-        case 0x20: registers[rd] = registers[rs] + registers[rt];
-            cout << "Instruction: add " << getNamedRegister(rd)
+        case OpHandler::Add: registers[rd] = registers[rs] + registers[rt];
+            out << "Instruction: add " << getNamedRegister(rd)
                 << ", " << getNamedRegister(rs) << ", " << getNamedRegister(rt) << '\n';
-            cout << "  Values: " << registerName(rs) << " = " << registers[rs]
+            out << "  Values: " << registerName(rs) << " = " << registers[rs]
                 << ", " << registerName(rt) << " = " << registers[rt] << '\n';
-            cout << "  Result: " << registerName(rd) << " = "
+            out << "  Result: " << registerName(rd) << " = "
                 << registers[rs] << " + " << registers[rt]
                 << " = " << registers[rd] << '\n';
             break;
 
         // Sub - Function Code 34    
-        case 0x22: registers[rd] = registers[rs] - registers[rt];
-            cout << "Instruction: sub " << getNamedRegister(rd)
+        case OpHandler::Sub: registers[rd] = registers[rs] - registers[rt];
+            out << "Instruction: sub " << getNamedRegister(rd)
                 << ", " << getNamedRegister(rs) << ", " << getNamedRegister(rt) << '\n';
-            cout << "  Values: " << registerName(rs) << " = " << registers[rs]
+            out << "  Values: " << registerName(rs) << " = " << registers[rs]
                 << ", " << registerName(rt) << " = " << registers[rt] << '\n';
-            cout << "  Result: " << registerName(rd) << " = "
+            out << "  Result: " << registerName(rd) << " = "
                 << registers[rs] << " - " << registers[rt]
                 << " = " << registers[rd] << '\n';
             break;
 
         // And - Function Code 36
-        case 0x24: registers[rd] = registers[rs] & registers[rt];
-            cout << "Instruction: and " << getNamedRegister(rd) << ", " 
-                << getNamedRegister(rs) << ", " << getNamedRegister(rt) << endl;
-            cout << "  Values: " << getNamedRegister(rs) << " = " << registers[rs] << ", "
-                << getNamedRegister(rt) << " = " << registers[rt] << endl;
-            cout << "  Result: " << getNamedRegister(rd) << " = " 
-                << registers[rs] << " & " << registers[rt] << " = " << registers[rd] << endl;
+        case OpHandler::And: registers[rd] = registers[rs] & registers[rt];
+            out << "Instruction: and " << getNamedRegister(rd) << ", " 
+                << getNamedRegister(rs) << ", " << getNamedRegister(rt) << '\n';
+            out << "  Values: " << getNamedRegister(rs) << " = " << registers[rs] << ", "
+                << getNamedRegister(rt) << " = " << registers[rt] << '\n';
+            out << "  Result: " << getNamedRegister(rd) << " = " 
+                << registers[rs] << " & " << registers[rt] << " = " << registers[rd] << '\n';
             break;
 
         // Or - Function Code 37
-        case 0x25: registers[rd] = registers[rs] | registers[rt];
-            cout << "Instruction: or " << getNamedRegister(rd) << ", " 
-                << getNamedRegister(rs) << ", " << getNamedRegister(rt) << endl;
-            cout << "  Values: " << getNamedRegister(rs) << " = " << registers[rs] << ", "
-                << getNamedRegister(rt) << " = " << registers[rt] << endl;  
-            cout << "  Result: " << getNamedRegister(rd) << " = " 
-                << registers[rs] << " | " << registers[rt] << " = " << registers[rd] << endl;
+        case OpHandler::Or: registers[rd] = registers[rs] | registers[rt];
+            out << "Instruction: or " << getNamedRegister(rd) << ", " 
+                << getNamedRegister(rs) << ", " << getNamedRegister(rt) << '\n';
+            out << "  Values: " << getNamedRegister(rs) << " = " << registers[rs] << ", "
+                << getNamedRegister(rt) << " = " << registers[rt] << '\n';  
+            out << "  Result: " << getNamedRegister(rd) << " = " 
+                << registers[rs] << " | " << registers[rt] << " = " << registers[rd] << '\n';
             break;
 
         // Nor - Function Code 39
-        case 0x27: registers[rd] = ~(registers[rs] | registers[rt]);
-            cout << "Instruction: nor " << getNamedRegister(rd) << ", "
-                << getNamedRegister(rs) << ", " << getNamedRegister(rt) << endl;
-            cout << "  Values: " << getNamedRegister(rs) << " = " << registers[rs] << ", "
-                << getNamedRegister(rt) << " = " << registers[rt] << endl; 
-            cout << "  Result: " << getNamedRegister(rd) << " = ~("
-                << registers[rs] << " | " << registers[rt] << ") = " << registers[rd] << endl; 
+        case OpHandler::Nor: registers[rd] = ~(registers[rs] | registers[rt]);
+            out << "Instruction: nor " << getNamedRegister(rd) << ", "
+                << getNamedRegister(rs) << ", " << getNamedRegister(rt) << '\n';
+            out << "  Values: " << getNamedRegister(rs) << " = " << registers[rs] << ", "
+                << getNamedRegister(rt) << " = " << registers[rt] << '\n'; 
+            out << "  Result: " << getNamedRegister(rd) << " = ~("
+                << registers[rs] << " | " << registers[rt] << ") = " << registers[rd] << '\n'; 
             break; 
 
         // Slt - Function Code 42 
-        case 0x2A: registers[rd] = (int32_t)registers[rs] < (int32_t)registers[rt];
-            cout << "Instruction: slt " << getNamedRegister(rd) << ", "
-                << getNamedRegister(rs) << ", " << getNamedRegister(rt) << endl;
-            cout << "  Values: " << getNamedRegister(rs) << " = " << static_cast<int32_t>(registers[rs]) << ", "
-                << getNamedRegister(rt) << " = " << static_cast<int32_t>(registers[rt]) << endl;
-            cout << "  Result: " << getNamedRegister(rd) << " = ("
+        case OpHandler::Slt: registers[rd] = (int32_t)registers[rs] < (int32_t)registers[rt];
+            out << "Instruction: slt " << getNamedRegister(rd) << ", "
+                << getNamedRegister(rs) << ", " << getNamedRegister(rt) << '\n';
+            out << "  Values: " << getNamedRegister(rs) << " = " << static_cast<int32_t>(registers[rs]) << ", "
+                << getNamedRegister(rt) << " = " << static_cast<int32_t>(registers[rt]) << '\n';
+            out << "  Result: " << getNamedRegister(rd) << " = ("
                 << static_cast<int32_t>(registers[rs]) << " < " << static_cast<int32_t>(registers[rt]) << ") → "
-                << registers[rd] << endl;
+                << registers[rd] << '\n';
             break;
 
         default:
-            cerr << "Unknown R-type funct: " << funct << "\n";
+            trace->flush();
+            cerr << "Unknown R-type funct: " << getFunct(instruction) << "\n";
             break;
     }
 
-    cout << "\nModified Registers\n";
-    cout << registerName(rs) << " = " << registers[rs] << endl;
-    cout << registerName(rt) << " = " << registers[rt] << endl;
-    cout << registerName(rd) << " = " << registers[rd] << endl << endl;
+    out << "\nModified Registers\n";
+    out << registerName(rs) << " = " << registers[rs] << '\n';
+    out << registerName(rt) << " = " << registers[rt] << '\n';
+    out << registerName(rd) << " = " << registers[rd] << '\n' << '\n';
+    return false;
 }
 
 /*
 | 31-26 | 25-21 | 20-16 | 15-0 |
 |opcode |  rs   |  rt   |  imm | 
 */
-void TinyMipsCPU::runStyleIType(uint32_t instruction, uint32_t opcode) {
-    uint32_t rs = getRs(instruction);
-    uint32_t rt = getRt(instruction);
-    int16_t imm = getImmediate(instruction);
-
-    if (DEBUG_MODE) {
-        cout << "**> Starting I-Type instruction " << endl;
-        displayBits(rs, 5);
-        displayBits(rt, 5);
-        displayBits(imm, 16);
+bool TinyMipsCPU::runStyleIType(const DecodedOp& op, uint32_t instruction) {
+    ostream& out = trace->out();
+    uint32_t rs = op.rs;
+    uint32_t rt = op.rt;
+    int16_t imm = static_cast<int16_t>(op.imm);
+
+    if (debugMode) {
+        out << "**> Starting I-Type instruction " << '\n';
+        displayBits(out, rs, 5);
+        displayBits(out, rt, 5);
+        displayBits(out, imm, 16);
     }
 
-    switch (opcode) {
+    switch (op.handler) {
         // Beq - Function Code 4
-        case 0x4:
-            cout << "Instruction: beq " << getNamedRegister(rs) << ", " << getNamedRegister(rt)
-                << ", offset = " << static_cast<int16_t>(imm) << endl;
-            cout << "  Values: " << getNamedRegister(rs) << " = " << registers[rs]
-                << ", " << getNamedRegister(rt) << " = " << registers[rt] << endl;
+        case OpHandler::Beq:
+            out << "Instruction: beq " << getNamedRegister(rs) << ", " << getNamedRegister(rt)
+                << ", offset = " << static_cast<int16_t>(imm) << '\n';
+            out << "  Values: " << getNamedRegister(rs) << " = " << registers[rs]
+                << ", " << getNamedRegister(rt) << " = " << registers[rt] << '\n';
 
             if (registers[rs] == registers[rt]) {
-                uint32_t targetPC = pc + 4 + (static_cast<int16_t>(imm) << 2);
-                cout << "  Branch Taken: PC set to " << targetPC << " (0x" << hex << targetPC << dec << ")" << endl;
+                // Target was resolved to pc + 4 + (imm << 2) at load time
+                uint32_t targetPC = op.target;
+                out << "  Branch Taken: PC set to " << targetPC << " (0x" << hex << targetPC << dec << ")" << '\n';
                 pc = targetPC;
-                return;
+                return true;
             } else {
-                cout << "  Branch Not Taken" << endl;
+                out << "  Branch Not Taken" << '\n';
             }
             break;
 
         // Addi - Function Code 8
-        case 0x8: { 
-            cout << "Instruction: addi " << getNamedRegister(rt) << ", "
-                << getNamedRegister(rs) << ", " << static_cast<int16_t>(imm) << endl;
-            cout << "  Values: " << getNamedRegister(rs) << " = " << registers[rs] << endl;
+        case OpHandler::Addi: { 
+            out << "Instruction: addi " << getNamedRegister(rt) << ", "
+                << getNamedRegister(rs) << ", " << static_cast<int16_t>(imm) << '\n';
+            out << "  Values: " << getNamedRegister(rs) << " = " << registers[rs] << '\n';
 
             int32_t result = static_cast<int32_t>(registers[rs]) + static_cast<int16_t>(imm);
             registers[rt] = result;
-            cout << "  Result: " << getNamedRegister(rt) << " = "
+            out << "  Result: " << getNamedRegister(rt) << " = "
                 << static_cast<int32_t>(registers[rs]) << " + " << static_cast<int16_t>(imm)
-                << " = " << result << endl;
+                << " = " << result << '\n';
             break;
         }
 
         // Load Word - Function Code 35
-        case 0x23: {
+        case OpHandler::Lw: {
 
             uint32_t addr = registers[rs] + static_cast<int16_t>(imm);
             uint32_t value = loadWord(addr);
             registers[rt] = value;
 
-            cout << "Instruction: lw " << getNamedRegister(rt) << ", "
-                << static_cast<int16_t>(imm) << "(" << getNamedRegister(rs) << ")" << endl;
-            cout << "  Effective address: " << addr << endl;
-            cout << "  Loaded value: " << value << " -> " << getNamedRegister(rt) << endl;
+            out << "Instruction: lw " << getNamedRegister(rt) << ", "
+                << static_cast<int16_t>(imm) << "(" << getNamedRegister(rs) << ")" << '\n';
+            out << "  Effective address: " << addr << '\n';
+            out << "  Loaded value: " << value << " -> " << getNamedRegister(rt) << '\n';
             break;
         }
 
         // Store Word - Function Code 43       
-        case 0x2B: {
+        case OpHandler::Sw: {
             int32_t address = static_cast<int32_t>(registers[rs]) + static_cast<int16_t>(imm);
             storeWord(address, registers[rt]);
 
-            cout << "Instruction: sw " << getNamedRegister(rt) << ", " << static_cast<int16_t>(imm)
+            out << "Instruction: sw " << getNamedRegister(rt) << ", " << static_cast<int16_t>(imm)
                 << "(" << getNamedRegister(rs) << ")\n";
-            cout << "  Effective address: " << address << "\n";
-            cout << "  Stored " << getNamedRegister(rt) << " (value: " << registers[rt]
+            out << "  Effective address: " << address << "\n";
+            out << "  Stored " << getNamedRegister(rt) << " (value: " << registers[rt]
                 << ") into M[" << address << "]\n";
 
             displayMemory(address, address + 4);
-            cout << endl;
+            out << '\n';
             break;
         }
 
         default:
-            cerr << "Unknown I-type opcode: " << opcode << endl;
+            trace->flush();
+            cerr << "Unknown I-type opcode: " << getOpcode(instruction) << endl;
             break;
     }
+    return false;
 }
 
 /*
 | 31-26 | 25-0  |
 |opcode |  addr | 
 */
-void TinyMipsCPU::runStyleJType(uint32_t instruction) {
-    uint32_t addr = getAddress(instruction);        
-    uint32_t addrShift = (addr << 2);              
-    uint32_t upperFour = pc & 0xF0000000;           
-    uint32_t fullJumpAddress = upperFour | addrShift;
-
-    if (DEBUG_MODE) {
-        cout << "**> Starting J-Type instruction\n";
-        cout << "Raw address: 0x" << hex << addr << "\n";
-        cout << "Shifted:     0x" << addrShift << "\n";
-        cout << "PC Upper:    0x" << upperFour << "\n";
-        cout << "Full Jump:   0x" << fullJumpAddress << "\n";
+bool TinyMipsCPU::runStyleJType(const DecodedOp& op, uint32_t instruction) {
+    ostream& out = trace->out();
+    // Full jump address was resolved at load time
+    uint32_t fullJumpAddress = op.target;
+
+    if (debugMode) {
+        uint32_t addr = getAddress(instruction);        
+        uint32_t addrShift = (addr << 2);              
+        uint32_t upperFour = pc & 0xF0000000;           
+
+        out << "**> Starting J-Type instruction\n";
+        out << "Raw address: 0x" << hex << addr << "\n";
+        out << "Shifted:     0x" << addrShift << "\n";
+        out << "PC Upper:    0x" << upperFour << "\n";
+        out << "Full Jump:   0x" << fullJumpAddress << "\n";
     }
 
-    cout << "Instruction: j 0x" << hex << fullJumpAddress << dec << endl;
-    cout << "  Jumping to address: " << fullJumpAddress << endl;
+    out << "Instruction: j 0x" << hex << fullJumpAddress << dec << '\n';
+    out << "  Jumping to address: " << fullJumpAddress << '\n';
 
     pc = fullJumpAddress;
+    return true;
 }
 
 
+// Every address is valid - untouched memory reads as 0
 uint32_t TinyMipsCPU::loadWord(uint32_t addr) const {
-    // Check Mem Bounds
-    if (addr + 3 >= memory.size()) 
-        return 0;
-
-    uint32_t msb = memory[addr] << 24;
-    uint32_t nsb1 = memory[addr + 1] << 16;
-    uint32_t nsb2 = memory[addr + 2] << 8;
-    uint32_t lsb = memory[addr + 3];
-
-    if (DEBUG_MODE) {
-        cout << "- Load Word Bits - ";
-        cout << msb << " " << nsb1 <<  " " << nsb2 <<  " " << lsb << endl;
+    uint32_t val = memory.loadWord(addr);
+
+    if (debugMode) {
+        ostream& out = trace->out();
+        out << "- Load Word Bits - ";
+        out << (val & 0xFF000000) << " " << (val & 0xFF0000) <<  " " << (val & 0xFF00)
+            <<  " " << (val & 0xFF) << '\n';
     }
-    return msb | nsb1 | nsb2 | lsb;
+    return val;
 }
 
+// The first store to a page allocates it
 void TinyMipsCPU::storeWord(uint32_t addr, uint32_t val) {
-    // Check Mem Bounds
-    if (addr + 3 >= memory.size()) 
-        return;
-
-    if (DEBUG_MODE) {
-        cout << "- Store Word Bits - ";
-        cout << ((val >> 24) & 0xFF) << " ";
-        cout << ((val >> 16) & 0xFF) <<  " ";
-        cout << ((val >> 8) & 0xFF) << " ";
-        cout << (val & 0xFF) << endl;
+    if (debugMode) {
+        ostream& out = trace->out();
+        out << "- Store Word Bits - ";
+        out << ((val >> 24) & 0xFF) << " ";
+        out << ((val >> 16) & 0xFF) <<  " ";
+        out << ((val >> 8) & 0xFF) << " ";
+        out << (val & 0xFF) << '\n';
     }
 
-    memory[addr] = (val >> 24) & 0xFF;
-    memory[addr + 1] = (val >> 16) & 0xFF;
-    memory[addr + 2] = (val >> 8) & 0xFF;
-    memory[addr + 3] = val & 0xFF; 
+    memory.storeWord(addr, val);
 }
 
 // Function to display the register
@@ -390,24 +761,7 @@ string TinyMipsCPU::registerName(uint32_t reg) const {
 
 // Will map the register value to the assembly name
 string TinyMipsCPU::getNamedRegister(uint32_t reg) const {
-    static const unordered_map<uint32_t, string> regMap = {
-        {0, "$zero"}, {1, "$at"},   {2, "$v0"},  {3, "$v1"},
-        {4, "$a0"},   {5, "$a1"},   {6, "$a2"},  {7, "$a3"},
-        {8, "$t0"},   {9, "$t1"},   {10, "$t2"}, {11, "$t3"}, 
-        {12, "$t4"},  {13, "$t5"},  {14, "$t6"}, {15, "$t7"},
-        {16, "$s0"},  {17, "$s1"},  {18, "$s2"}, {19, "$s3"},  
-        {20, "$s4"},  {21, "$s5"},  {22, "$s6"}, {23, "$s7"},
-        {24, "$t8"},  {25, "$t9"},  {26, "$k0"}, {27, "$k1"}, 
-        {28, "$gp"},  {29, "$sp"},  {30, "$fp"}, {31, "$ra"} 
-    };  
-
-    auto it = regMap.find(reg); 
-    if (it != regMap.end()) {
-        return it->second; 
-    } else {
-        // Fallback 
-        return "$r" + to_string(reg);  
-    }
+    return namedRegister(reg);
 }
 
 // Helper function to extract the bits from instruction
@@ -450,8 +804,61 @@ uint32_t TinyMipsCPU::getAddress(uint32_t instruction) const {
     return extractBits(instruction, 0, 26);
 }
 
+// Decodes once at load time: fields, handler and resolved branch target
+DecodedOp TinyMipsCPU::decodeInstruction(uint32_t instruction, uint32_t instrPc) const {
+    DecodedOp op{};
+    op.rs = static_cast<uint8_t>(getRs(instruction));
+    op.rt = static_cast<uint8_t>(getRt(instruction));
+    op.rd = static_cast<uint8_t>(getRd(instruction));
+    op.imm = getImmediate(instruction);
+
+    uint32_t opcode = getOpcode(instruction);
+    if (opcode == 0) {
+        switch (getFunct(instruction)) {
+            case 0x20: op.handler = OpHandler::Add; break;
+            case 0x22: op.handler = OpHandler::Sub; break;
+            case 0x24: op.handler = OpHandler::And; break;
+            case 0x25: op.handler = OpHandler::Or; break;
+            case 0x27: op.handler = OpHandler::Nor; break;
+            case 0x2A: op.handler = OpHandler::Slt; break;
+            default:   op.handler = OpHandler::UnknownR; break;
+        }
+    } else if (opcode == 2 || opcode == 3) {
+        op.handler = OpHandler::J;
+        op.target = (instrPc & 0xF0000000) | (getAddress(instruction) << 2);
+    } else {
+        switch (opcode) {
+            case 0x04:
+                op.handler = OpHandler::Beq;
+                op.target = instrPc + 4 + (static_cast<uint32_t>(op.imm) << 2);
+                break;
+            case 0x08: op.handler = OpHandler::Addi; break;
+            case 0x23: op.handler = OpHandler::Lw; break;
+            case 0x2B: op.handler = OpHandler::Sw; break;
+            default:   op.handler = OpHandler::UnknownI; break;
+        }
+    }
+    return op;
+}
+
+// Only pairs whose first op falls through, so both always run in order
+FusedPair TinyMipsCPU::fusePair(const DecodedOp& first, const DecodedOp& second) {
+    if (first.handler == OpHandler::Addi) {
+        switch (second.handler) {
+            case OpHandler::Beq: return FusedPair::AddiBeq;
+            case OpHandler::Lw:  return FusedPair::AddiLw;
+            case OpHandler::Sw:  return FusedPair::AddiSw;
+            case OpHandler::J:   return FusedPair::AddiJ;
+            default:             return FusedPair::None;
+        }
+    }
+    if (first.handler == OpHandler::Slt && second.handler == OpHandler::Beq)
+        return FusedPair::SltBeq;
+    return FusedPair::None;
+}
+
 // Debugging visual bit display
-void displayBits(uint32_t bits, int numBits) {
+void displayBits(ostream& out, uint32_t bits, int numBits) {
     // Mask to keep only the numBits lower bits
     uint32_t mask = (numBits >= 32) ? 0xFFFFFFFF : ((1u << numBits) - 1);
     bits &= mask;
@@ -460,6 +867,6 @@ void displayBits(uint32_t bits, int numBits) {
     bitset<32> b(bits); 
     string output = b.to_string().substr(32 - numBits);
 
-    cout << "Decimal: " << bits << "\n";
-    cout << "Binary (" << numBits << " bits): " << output << "\n";
+    out << "Decimal: " << bits << "\n";
+    out << "Binary (" << numBits << " bits): " << output << "\n";
 }
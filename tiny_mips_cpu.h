@@ -12,7 +12,8 @@
   Description:
                Defines the TinyMipsCPU class that simulates execution of 32-bit 
                binary MIPS instructions. Supports a basic register file, 
-               instruction memory, and memory for load/store operations. 
+               instruction memory, and a sparse 32-bit data memory for
+               load/store operations (paged_memory.h). 
                Implements 10 instructions:
 
                - R-type: add, sub, and, or, slt, nor
@@ -34,18 +35,146 @@
 #include <array>
 #include <string>
 #include <unordered_set>
+#include <memory>
+#include "trace_sink.h"
+#include "retire_trace.h"
+#include "paged_memory.h"
+#include "timing_model.h"
 
+// Handler picked once per instruction when the program is loaded
+enum class OpHandler : uint8_t {
+    Add, Sub, And, Or, Nor, Slt, UnknownR,
+    Beq, Addi, Lw, Sw, UnknownI,
+    J
+};
+
+// Adjacent pair the threaded engine runs as one handler (found at load time)
+enum class FusedPair : uint8_t {
+    None,
+    // Counter bump then test, pointer bump then access, bump then loop back
+    AddiBeq, AddiLw, AddiSw, AddiJ,
+    // Compare then branch on the result
+    SltBeq
+};
+
+// Interpreter used by executeProgram
+enum class ExecEngine {
+    // performStep per instruction with full trace output
+    Step,
+    // Direct-threaded loop over the decoded program, no per-step output
+    Threaded,
+    // Basic blocks compiled to x86-64 (tiny_mips_jit.cpp), no per-step output
+    Jit
+};
+
+// Why a fast engine handed control back to executeProgram
+enum class StopReason {
+    // pc left the loaded program
+    Halt,
+    // Instruction the fast engine does not implement (left for performStep)
+    Fault,
+    // Step budget used up
+    Budget
+};
+
+struct RunResult {
+    StopReason reason;
+    uint64_t retired;
+};
+
+// Architectural effect of one retired instruction
+struct StepEffect {
+    // Register written (-1 if none) and its new value
+    int destReg = -1;
+    uint32_t destValue = 0;
+    // Effective address and word for lw/sw
+    bool memRead = false;
+    bool memWrite = false;
+    uint32_t memAddress = 0;
+    uint32_t memValue = 0;
+    // beq taken or j
+    bool branchTaken = false;
+};
+
+// Instruction fields extracted once by loadProgram (12 bytes per op)
+class TinyMipsJit;
 
+struct DecodedOp {
+    OpHandler handler;
+    uint8_t rs;
+    uint8_t rt;
+    uint8_t rd;
+    // Sign-extended 16-bit immediate (raw low bits for R-type)
+    int32_t imm;
+    // Resolved destination pc for beq and j
+    uint32_t target;
+};
 
 class TinyMipsCPU {
 public:
     TinyMipsCPU();
+    ~TinyMipsCPU();
     // Load binary instructions (as 32-bit unsigned integers) 
     void loadProgram(const std::vector<uint32_t>& instructions); 
+    // Load instructions straight from a word buffer (e.g. a mapped object file)
+    void loadProgram(const uint32_t* words, size_t count);
+    // Take over an assembled word vector without copying it
+    void loadProgram(std::vector<uint32_t>&& instructions);
     // Run the program until completion - jumps to invalid PC or runs out of code
     void executeProgram(); 
+    // Run until stepsExecuted() reaches stepCount. Returns true if the run
+    // paused there (call again to continue), false if the program finished,
+    // faulted or hit the step limit first.
+    bool executeUntil(uint64_t stepCount);
     // Execute one instruction and update PC
     bool performStep(); 
+    // Choose the interpreter used by executeProgram
+    void setEngine(ExecEngine selected) { engine = selected; }
+    // Let the threaded engine run fused pairs (on by default)
+    void setFusion(bool enabled);
+    // Trace verbosity and where it is written (stdout sink by default)
+    void setTrace(TraceLevel level, TraceSink& sink);
+    TraceLevel getTraceLevel() const { return traceLevel; }
+    TraceSink& traceSink() const { return *trace; }
+    // Binary record per retired instruction (nullptr stops recording). The
+    // JIT does not record, so the threaded engine runs in its place.
+    void setRetireTrace(RetireTraceWriter* writer) { retireTrace = writer; }
+    // Performance models fed every retired instruction (nullptr detaches).
+    // Like the retire trace, the JIT hands over to the threaded engine.
+    void setTimingModel(TimingModel* model) { timing = model; }
+    // Override the step limit (call after loadProgram, which resets it)
+    void setMaxSteps(uint64_t limit);
+    // Extra bit-level output from the step engine (off by default)
+    void setDebugMode(bool enabled) { debugMode = enabled; }
+    // Byte order of data memory words seen by lw and sw (big-endian by default)
+    void setEndianness(Endianness order) { memory.setEndianness(order); }
+    Endianness endianness() const { return memory.endianness(); }
+    // Copies a memory image to data address 0; throws std::runtime_error if
+    // it is larger than the 4 GiB address space
+    void loadMemoryImage(const uint8_t* bytes, size_t size);
+    // Instruction words passed to loadProgram
+    const std::vector<uint32_t>& loadedProgram() const { return instructionMemory; }
+    // Instructions retired since the program was loaded
+    uint64_t stepsExecuted() const;
+    // Fused pairs the threaded engine ran since the program was loaded
+    // (each retires two of the instructions above)
+    uint64_t fusedPairsExecuted() const { return fusedPairs; }
+    // True when the last run was stopped by the step limit
+    bool hitStepLimit() const { return steps > maxSteps; }
+    // 64-bit FNV-1a hash of pc, registers and memory, for comparing runs
+    uint64_t stateHash() const;
+    // 64-bit FNV-1a hash of the loaded instruction words
+    uint64_t programHash() const;
+    // Writes pc, registers, memory, byte order and the step count to a
+    // checkpoint file (checkpoint.h); throws std::runtime_error
+    void saveCheckpoint(const std::string& path) const;
+    // Replaces that state with a checkpoint of the loaded program; throws
+    // std::runtime_error for another program or a corrupt file
+    void restoreCheckpoint(const std::string& path);
+    // Data memory pages allocated so far (PagedMemory::PAGE_SIZE bytes each)
+    size_t residentPages() const { return memory.residentPages(); }
+    // Describes the first pc/register/memory difference, empty if identical
+    std::string describeStateDifference(const TinyMipsCPU& other) const;
     // Print the current register state 
     void displayRegisters() const; 
     void displayRegisters1(const std::unordered_set<int>& changedRegs) const;
@@ -54,14 +183,43 @@ public:
 
 
 private:
+    friend class TinyMipsJit;
+
+    // Selected interpreter
+    ExecEngine engine;
+    // Trace verbosity and the buffered sink all output goes through
+    TraceLevel traceLevel;
+    TraceSink* trace;
+    // Receive a RetireRecord per instruction when set
+    RetireTraceWriter* retireTrace;
+    TimingModel* timing;
+    // Step limit used to catch infinite loops from bad test code, and the
+    // instructions retired so far
+    uint64_t maxSteps;
+    uint64_t steps;
+    // Bit-level debug output from the step engine
+    bool debugMode;
     // Program counter           
     uint32_t pc;  
     // Register range from 0-31
     std::array<uint32_t, 32> registers; 
-    // Simplified flat memory
-    std::vector<uint8_t> memory;
+    // Sparse data memory covering the whole 32-bit address space
+    PagedMemory memory;
     // Memory representation where insturctions are loaded
     std::vector<uint32_t> instructionMemory;
+    // Pre-decoded copy of instructionMemory, one entry per word
+    std::vector<DecodedOp> decodedProgram;
+    // Pair starting at each word, FusedPair::None where there is none
+    std::vector<FusedPair> fusedProgram;
+    // Threaded engine uses fusedProgram, and the pairs it has run
+    bool fusionEnabled;
+    uint64_t fusedPairs;
+    // Threaded engine handler slot per word, plus a final halt slot
+    std::vector<uint8_t> threadedProgram;
+    // JIT code for the loaded program, kept between executeUntil calls
+    std::unique_ptr<TinyMipsJit> jit;
+    // A JIT fallback warning was printed since loadProgram
+    bool jitWarned;
     
     // Instruction decoding helpers accesses
     uint32_t getOpcode(uint32_t instruction) const; 
@@ -72,13 +230,42 @@ private:
     int16_t  getImmediate(uint32_t instruction) const;
     uint32_t getShamt(uint32_t instruction) const;
     uint32_t getAddress(uint32_t instruction) const; 
+    // Extract every field of the word at instrPc into a DecodedOp
+    DecodedOp decodeInstruction(uint32_t instruction, uint32_t instrPc) const;
+    // Pair formed by two adjacent decoded ops, FusedPair::None if they
+    // cannot be fused
+    static FusedPair fusePair(const DecodedOp& first, const DecodedOp& second);
+    // Decodes instructionMemory and resets the run state (every loadProgram)
+    void prepareLoadedProgram();
+
+    // Untraced execution of one op - returns true when the pc was redirected
+    bool executeOp(const DecodedOp& op, StepEffect& effect);
+    // Effect of a step run through runStyle*, from the source operand values
+    // read before it executed and the register file afterwards
+    StepEffect effectOfStep(const DecodedOp& op, uint32_t rsValue, uint32_t rtValue,
+                            bool redirected) const;
+    // Packs an effect for the retire trace and the one-line trace
+    RetireRecord makeRetireRecord(uint32_t instrPc, const StepEffect& effect) const;
+
+    // Instruction implementations - return true when the pc was redirected
+    bool runStyleRType(const DecodedOp& op, uint32_t instruction); 
+    bool runStyleIType(const DecodedOp& op, uint32_t instruction);
+    bool runStyleJType(const DecodedOp& op, uint32_t instruction); 
 
-    // Instruction implementations
-    void runStyleRType(uint32_t instruction); 
-    void runStyleIType(uint32_t instruction, uint32_t opcode);
-    void runStyleJType(uint32_t instruction); 
+    // Threaded engine (tiny_mips_fast.cpp) - runs at most budget instructions
+    RunResult runThreaded(uint64_t budget);
+    // Fills threadedProgram from decodedProgram, fusedProgram and fusionEnabled
+    void buildThreadedProgram();
+    // Loop body, instantiated with and without retire records (for the
+    // retire trace and the timing model)
+    template <bool Record>
+    RunResult runThreadedLoop(uint64_t budget);
+    // Runs the threaded or JIT engine under the executeProgram step limit,
+    // pausing at stepCount (same result as executeUntil)
+    bool executeFast(uint64_t stepCount);
 
-    // Memory helpers
+    // Memory helpers for the traced step path (with debug output); the
+    // untraced paths use memory.loadWord/storeWord directly
     uint32_t loadWord(uint32_t address) const; 
     void storeWord(uint32_t address, uint32_t value);
 
@@ -86,7 +273,5 @@ private:
     std::string registerName(uint32_t reg) const;
     std::string getNamedRegister(uint32_t reg) const;
 };
-   
-extern bool DEBUG_MODE;
 
 #endif // TINY_MIPS_CPU_H 
\ No newline at end of file
@@ -0,0 +1,265 @@
+/*------------------------------------------------------------------------------
+  File:        tiny_mips_fast.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Direct-threaded fast interpreter for TinyMipsCPU
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Runs the pre-decoded program without any per-step output. The
+               pc and register file live in locals for the whole run and the
+               loop only returns on halt, an unsupported instruction (fault)
+               or when the step budget runs out.
+
+               With GCC/Clang each decoded op gets the address of its handler
+               label (computed goto). Other compilers use a switch in a loop.
+               Define TINY_MIPS_NO_COMPUTED_GOTO to force the switch version.
+
+               The loop is a template on whether a retire trace or timing
+               model is attached, so the untraced build of each handler has
+               no recording code at all and the traced one only builds a
+               24-byte record for the trace buffer and the models.
+
+               The slot of every instruction is worked out once per program
+               (and again when fusion is switched), so pausing and resuming
+               the loop costs nothing per instruction.
+
+               Pairs found by loadProgram (addi then beq, lw, sw or j, and
+               slt then beq) are dispatched once: the pair handler runs the
+               first op and goes straight to the second op's body. Both still
+               retire and count as steps on their own, and a budget that ends
+               between them stops there, so results match the unfused loop.
+------------------------------------------------------------------------------*/
+
+#include "tiny_mips_cpu.h"
+#include <vector>
+
+#if defined(__GNUC__) && !defined(TINY_MIPS_NO_COMPUTED_GOTO)
+#define TINY_MIPS_COMPUTED_GOTO 1
+// Labels as values are a GNU extension
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+using namespace std;
+
+// Handler bodies of the threaded loop; threadedProgram holds one per word
+enum ThreadedSlot : uint8_t {
+    Slot_add, Slot_sub, Slot_and, Slot_or, Slot_nor, Slot_slt,
+    Slot_beq, Slot_addi, Slot_lw, Slot_sw, Slot_j,
+    Slot_addi_beq, Slot_addi_lw, Slot_addi_sw, Slot_addi_j, Slot_slt_beq,
+    Slot_fault, Slot_halt
+};
+
+// Indexed by OpHandler
+static const uint8_t handlerSlots[] = {
+    Slot_add, Slot_sub, Slot_and, Slot_or, Slot_nor, Slot_slt, Slot_fault,
+    Slot_beq, Slot_addi, Slot_lw, Slot_sw, Slot_fault,
+    Slot_j
+};
+
+// Indexed by FusedPair (None is never looked up)
+static const uint8_t pairSlots[] = {
+    Slot_halt, Slot_addi_beq, Slot_addi_lw, Slot_addi_sw, Slot_addi_j, Slot_slt_beq
+};
+
+void TinyMipsCPU::buildThreadedProgram() {
+    size_t count = decodedProgram.size();
+    threadedProgram.resize(count + 1);
+    for (size_t i = 0; i < count; ++i)
+        threadedProgram[i] = (fusionEnabled && fusedProgram[i] != FusedPair::None)
+                                 ? pairSlots[static_cast<size_t>(fusedProgram[i])]
+                                 : handlerSlots[static_cast<size_t>(decodedProgram[i].handler)];
+    // Falling off the end of the program hits halt
+    threadedProgram[count] = Slot_halt;
+}
+
+RunResult TinyMipsCPU::runThreaded(uint64_t budget) {
+    return (retireTrace || timing) ? runThreadedLoop<true>(budget) : runThreadedLoop<false>(budget);
+}
+
+template <bool Record>
+RunResult TinyMipsCPU::runThreadedLoop(uint64_t budget) {
+    const size_t count = decodedProgram.size();
+    const DecodedOp* ops = decodedProgram.data();
+    const uint8_t* code = threadedProgram.data();
+    const uint32_t* words = instructionMemory.data();
+
+    // Working copies kept in locals for the whole run
+    uint32_t regs[32];
+    for (int i = 0; i < 32; ++i)
+        regs[i] = registers[i];
+    size_t index = pc / 4;
+    uint64_t retired = 0;
+    uint64_t fused = 0;
+    StopReason reason = StopReason::Halt;
+    const DecodedOp* op;
+
+    if (budget == 0)
+        return {StopReason::Budget, 0};
+    if (pc % 4 != 0 || index >= count)
+        return {StopReason::Halt, 0};
+
+#ifdef TINY_MIPS_COMPUTED_GOTO
+    // Indexed by ThreadedSlot
+    static const void* const labels[] = {
+        &&op_add, &&op_sub, &&op_and, &&op_or, &&op_nor, &&op_slt,
+        &&op_beq, &&op_addi, &&op_lw, &&op_sw, &&op_j,
+        &&op_addi_beq, &&op_addi_lw, &&op_addi_sw, &&op_addi_j, &&op_slt_beq,
+        &&op_fault, &&op_halt
+    };
+
+#define HANDLER(name) op_##name:
+#define DISPATCH() do { op = &ops[index]; goto *labels[code[index]]; } while (0)
+#define END_DISPATCH()
+#else
+#define HANDLER(name) case Slot_##name:
+#define DISPATCH() do { op = &ops[index]; goto dispatch; } while (0)
+#define END_DISPATCH() }
+#endif
+
+    // Retire the current op and move on, stopping once the budget is spent
+#define NEXT() do { if (++retired == budget) { reason = StopReason::Budget; goto done; } \
+                    DISPATCH(); } while (0)
+    // Taken branch or jump - targets outside the program halt with pc set
+#define JUMP_TO(target) do { pcTarget = (target); index = pcTarget / 4; \
+                             if (index >= count) { ++retired; goto halt_at_target; } \
+                             NEXT(); } while (0)
+    // Between the ops of a fused pair: retire the first op and move to the
+    // second without a dispatch, unless the budget ends in between
+#define PAIR_NEXT() do { ++index; if (++retired == budget) { reason = StopReason::Budget; goto done; } \
+                         ++fused; op = &ops[index]; } while (0)
+
+    // Hands the record for the op at index to the trace and the timing
+    // model (compiled out when not recording)
+#define RETIRE(destReg, destValue, flags, memAddress, memValue) do { if (Record) { \
+        const RetireRecord record{static_cast<uint32_t>(index * 4), words[index], (destValue), \
+                                  (memAddress), (memValue), (destReg), (flags), 0}; \
+        if (retireTrace) retireTrace->append(record); \
+        if (timing) timing->retire(record); } } while (0)
+
+    uint32_t pcTarget;
+    uint32_t address;
+    DISPATCH();
+
+#ifndef TINY_MIPS_COMPUTED_GOTO
+dispatch:
+    switch (code[index]) {
+#endif
+
+HANDLER(fault)
+    reason = StopReason::Fault;
+    goto done;
+
+HANDLER(add)
+    regs[op->rd] = regs[op->rs] + regs[op->rt];
+    RETIRE(op->rd, regs[op->rd], 0, 0, 0);
+    ++index; NEXT();
+HANDLER(sub)
+    regs[op->rd] = regs[op->rs] - regs[op->rt];
+    RETIRE(op->rd, regs[op->rd], 0, 0, 0);
+    ++index; NEXT();
+HANDLER(and)
+    regs[op->rd] = regs[op->rs] & regs[op->rt];
+    RETIRE(op->rd, regs[op->rd], 0, 0, 0);
+    ++index; NEXT();
+HANDLER(or)
+    regs[op->rd] = regs[op->rs] | regs[op->rt];
+    RETIRE(op->rd, regs[op->rd], 0, 0, 0);
+    ++index; NEXT();
+HANDLER(nor)
+    regs[op->rd] = ~(regs[op->rs] | regs[op->rt]);
+    RETIRE(op->rd, regs[op->rd], 0, 0, 0);
+    ++index; NEXT();
+HANDLER(slt)
+    regs[op->rd] = static_cast<int32_t>(regs[op->rs]) < static_cast<int32_t>(regs[op->rt]);
+    RETIRE(op->rd, regs[op->rd], 0, 0, 0);
+    ++index; NEXT();
+HANDLER(addi)
+    regs[op->rt] = regs[op->rs] + static_cast<uint32_t>(op->imm);
+    RETIRE(op->rt, regs[op->rt], 0, 0, 0);
+    ++index; NEXT();
+HANDLER(lw)
+run_lw:
+    address = regs[op->rs] + static_cast<uint32_t>(op->imm);
+    regs[op->rt] = memory.loadWord(address);
+    RETIRE(op->rt, regs[op->rt], RETIRE_MEM_READ, address, regs[op->rt]);
+    ++index; NEXT();
+HANDLER(sw)
+run_sw:
+    address = regs[op->rs] + static_cast<uint32_t>(op->imm);
+    memory.storeWord(address, regs[op->rt]);
+    RETIRE(RETIRE_NO_DEST, 0, RETIRE_MEM_WRITE, address, regs[op->rt]);
+    ++index; NEXT();
+HANDLER(beq)
+run_beq:
+    if (regs[op->rs] == regs[op->rt]) {
+        RETIRE(RETIRE_NO_DEST, 0, RETIRE_BRANCH_TAKEN, 0, 0);
+        JUMP_TO(op->target);
+    }
+    RETIRE(RETIRE_NO_DEST, 0, 0, 0, 0);
+    ++index; NEXT();
+HANDLER(j)
+run_j:
+    RETIRE(RETIRE_NO_DEST, 0, RETIRE_BRANCH_TAKEN, 0, 0);
+    JUMP_TO(op->target);
+
+    // Fused pairs: the first op here, the second at its run_ label
+HANDLER(addi_beq)
+    regs[op->rt] = regs[op->rs] + static_cast<uint32_t>(op->imm);
+    RETIRE(op->rt, regs[op->rt], 0, 0, 0);
+    PAIR_NEXT();
+    goto run_beq;
+HANDLER(addi_lw)
+    regs[op->rt] = regs[op->rs] + static_cast<uint32_t>(op->imm);
+    RETIRE(op->rt, regs[op->rt], 0, 0, 0);
+    PAIR_NEXT();
+    goto run_lw;
+HANDLER(addi_sw)
+    regs[op->rt] = regs[op->rs] + static_cast<uint32_t>(op->imm);
+    RETIRE(op->rt, regs[op->rt], 0, 0, 0);
+    PAIR_NEXT();
+    goto run_sw;
+HANDLER(addi_j)
+    regs[op->rt] = regs[op->rs] + static_cast<uint32_t>(op->imm);
+    RETIRE(op->rt, regs[op->rt], 0, 0, 0);
+    PAIR_NEXT();
+    goto run_j;
+HANDLER(slt_beq)
+    regs[op->rd] = static_cast<int32_t>(regs[op->rs]) < static_cast<int32_t>(regs[op->rt]);
+    RETIRE(op->rd, regs[op->rd], 0, 0, 0);
+    PAIR_NEXT();
+    goto run_beq;
+
+HANDLER(halt)
+    reason = StopReason::Halt;
+    goto done;
+
+END_DISPATCH()
+
+halt_at_target:
+    // Keep the out-of-range target as the final pc, like performStep
+    reason = (retired == budget) ? StopReason::Budget : StopReason::Halt;
+    for (int i = 0; i < 32; ++i)
+        registers[i] = regs[i];
+    pc = pcTarget;
+    fusedPairs += fused;
+    return {reason, retired};
+
+done:
+    for (int i = 0; i < 32; ++i)
+        registers[i] = regs[i];
+    pc = static_cast<uint32_t>(index * 4);
+    fusedPairs += fused;
+    return {reason, retired};
+
+#undef HANDLER
+#undef DISPATCH
+#undef END_DISPATCH
+#undef NEXT
+#undef JUMP_TO
+#undef PAIR_NEXT
+#undef RETIRE
+}
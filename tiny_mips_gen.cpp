@@ -0,0 +1,359 @@
+/*------------------------------------------------------------------------------
+  File:        tiny_mips_gen.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Synthetic workload generator. Writes large, parameterized
+               assembly programs for measuring the assembler and the
+               simulators at scale.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Workloads use only the instructions the simulator runs (add,
+               sub, and, or, nor, slt, addi, lw, sw, beq, j) and always
+               terminate:
+
+               - alu:    straight-line R-type and addi on $s0-$s6, $t8, $t9
+               - loops:  nested counted loops (counters in $t0-$t7) around
+                         an ALU body
+               - memory: strided lw/sw sweeps ($a0 pointer, $a1 count)
+               - labels: every instruction labeled, with beq that are never
+                         taken ($s7 is 1) and short forward j between them
+               - mixed:  one of each, in that order
+
+               The same seed gives the same file on every host: numbers come
+               from splitmix64 rather than <random> distributions, whose
+               results differ between standard libraries. The last line of
+               the file, also printed, gives the static instruction count
+               and the exact number of instructions a run retires (the
+               simulator's --max-steps needs at least that).
+
+  Dependencies:
+    - <iostream>, <fstream>, <string>, <vector>, <cstdint>, <cstdlib>
+  -----------------------------------------------------------------------------*/
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+enum class WorkloadKind { Alu, Loops, Memory, Labels, Mixed };
+
+// Command line settings
+struct GenOptions {
+    WorkloadKind kind = WorkloadKind::Mixed;
+    string outputPath;
+    uint64_t seed = 1;
+    // Static instructions for alu and labels
+    uint64_t size = 10000;
+    // Loop nest shape
+    unsigned depth = 3;
+    unsigned iterations = 10;
+    unsigned body = 8;
+    // Sweep shape: elements per sweep, bytes between them, sweep count
+    unsigned count = 1024;
+    unsigned stride = 4;
+    unsigned sweeps = 4;
+};
+
+// Largest count an addi immediate can load
+static const uint64_t MAX_IMMEDIATE = 32767;
+// Furthest a beq may reach, in instructions (16-bit word offset, with room)
+static const uint64_t BRANCH_REACH = 30000;
+
+static const char* const DATA_REGISTERS[] = {
+    "$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$t8", "$t9"
+};
+static const char* const COUNTER_REGISTERS[] = {
+    "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7"
+};
+static const char* const ALU_OPS[] = { "add", "sub", "and", "or", "nor", "slt" };
+
+// splitmix64: tiny, fast and identical everywhere
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : state(seed) { }
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform enough in [0, bound) for workload shapes
+    uint64_t below(uint64_t bound) { return next() % bound; }
+
+private:
+    uint64_t state;
+};
+
+// Writes instructions and keeps the static and retired counts
+class WorkloadWriter {
+public:
+    WorkloadWriter(ostream& out, uint64_t seed) : out(out), rng(seed), instructions(0), retired(0), labels(0) { }
+
+    void comment(const string& text) { out << "\n# " << text << '\n'; }
+
+    // count straight-line ALU instructions
+    void alu(uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i)
+            emit(randomAlu());
+        retired += count;
+    }
+
+    /**
+     * Nested counted loops: each level loads its counter, tests it at the
+     * top, runs the next level (or the ALU body) and counts down.
+     *
+     * @return Instructions one run of the nest retires
+     */
+    uint64_t loopNest(unsigned level, unsigned depth, unsigned iterations, unsigned body) {
+        if (level == depth) {
+            for (unsigned i = 0; i < body; ++i)
+                emit(randomAlu());
+            return body;
+        }
+        const string counter = COUNTER_REGISTERS[level];
+        string top = newLabel("loop");
+        string end = newLabel("done");
+        emit("addi " + counter + ", $zero, " + to_string(iterations));
+        out << top << ":\n";
+        emit("beq " + counter + ", $zero, " + end);
+        uint64_t inner = loopNest(level + 1, depth, iterations, body);
+        emit("addi " + counter + ", " + counter + ", -1");
+        emit("j " + top);
+        out << end << ":\n";
+        // Load, iterations + 1 tests, then inner + decrement + jump per pass
+        return 1 + (iterations + 1) + uint64_t(iterations) * (inner + 2);
+    }
+
+    // Counted sweep of lw/add/sw over count elements stride bytes apart
+    void sweep(unsigned count, unsigned stride) {
+        // Word-aligned base somewhere in the first 16 KiB
+        uint64_t base = rng.below(4096) * 4;
+        string top = newLabel("sweep");
+        string end = newLabel("done");
+        emit("addi $a0, $zero, " + to_string(base));
+        emit("addi $a1, $zero, " + to_string(count));
+        out << top << ":\n";
+        emit("beq $a1, $zero, " + end);
+        emit("lw $v0, 0($a0)");
+        emit("add $v0, $v0, $a1");
+        emit("sw $v0, 0($a0)");
+        emit("addi $a0, $a0, " + to_string(stride));
+        emit("addi $a1, $a1, -1");
+        emit("j " + top);
+        out << end << ":\n";
+        retired += 2 + (uint64_t(count) + 1) + uint64_t(count) * 6;
+    }
+
+    /**
+     * count labeled instructions. Roughly one in eight is a beq that is never
+     * taken and one in sixteen a j up to sixteen instructions ahead; now and
+     * then a label sits alone on its line.
+     */
+    void labelDense(uint64_t count) {
+        emit("addi $s7, $zero, 1");
+        ++retired;
+        uint64_t first = labels;
+        // Index of the j target (or the next instruction) for the retired count
+        vector<uint64_t> next(count);
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t label = first + i;
+            if (rng.below(32) == 0)
+                out << "L" << label << "_:\n";
+            out << "L" << label << ": ";
+            next[i] = i + 1;
+            uint64_t pick = rng.below(16);
+            if (pick < 2) {
+                // Never taken: anywhere within branch reach
+                uint64_t low = i > BRANCH_REACH ? i - BRANCH_REACH : 0;
+                uint64_t high = min(count - 1, i + BRANCH_REACH);
+                uint64_t target = low + rng.below(high - low + 1);
+                emit("beq $s7, $zero, L" + to_string(first + target));
+            } else if (pick == 2 && i + 1 < count) {
+                uint64_t target = min(count - 1, i + 1 + rng.below(16));
+                emit("j L" + to_string(first + target));
+                next[i] = target;
+            } else {
+                emit(randomAlu());
+            }
+        }
+        labels += count;
+        for (uint64_t i = 0; i < count; i = next[i])
+            ++retired;
+    }
+
+    void addRetired(uint64_t count) { retired += count; }
+    uint64_t instructionCount() const { return instructions; }
+    uint64_t retiredCount() const { return retired; }
+
+private:
+    void emit(const string& instruction) {
+        out << instruction << '\n';
+        ++instructions;
+    }
+
+    string newLabel(const char* kind) { return string(kind) + to_string(labels++); }
+
+    const char* dataRegister() {
+        return DATA_REGISTERS[rng.below(sizeof(DATA_REGISTERS) / sizeof(DATA_REGISTERS[0]))];
+    }
+
+    string randomAlu() {
+        // One in four is an addi
+        if (rng.below(4) == 0) {
+            int immediate = static_cast<int>(rng.below(2001)) - 1000;
+            return string("addi ") + dataRegister() + ", " + dataRegister() + ", " + to_string(immediate);
+        }
+        const char* op = ALU_OPS[rng.below(sizeof(ALU_OPS) / sizeof(ALU_OPS[0]))];
+        return string(op) + ' ' + dataRegister() + ", " + dataRegister() + ", " + dataRegister();
+    }
+
+    ostream& out;
+    Rng rng;
+    uint64_t instructions;
+    uint64_t retired;
+    // Labels handed out so far, so every section's names are unique
+    uint64_t labels;
+};
+
+static void printUsage() {
+    cerr << "Usage: ./tiny_mips_gen [options] <alu|loops|memory|labels|mixed> <output.s>\n"
+         << "  --seed=N        Random seed (default 1)\n"
+         << "  --size=N        Instructions for alu and labels (default 10000)\n"
+         << "  --depth=N       Loop nest depth, 1-8 (default 3)\n"
+         << "  --iterations=N  Iterations per loop level (default 10)\n"
+         << "  --body=N        ALU instructions in the innermost loop (default 8)\n"
+         << "  --count=N       Elements per memory sweep (default 1024)\n"
+         << "  --stride=N      Bytes between swept elements (default 4)\n"
+         << "  --sweeps=N      Number of memory sweeps (default 4)\n";
+}
+
+// Accepts decimal or 0x-prefixed hex
+static bool parseNumber(const string& text, uint64_t& value) {
+    if (text.empty())
+        return false;
+    char* end = nullptr;
+    value = strtoull(text.c_str(), &end, 0);
+    return *end == '\0';
+}
+
+// Parses "--name=N" into value when arg starts with prefix, checking the range
+static bool parseBounded(const string& arg, const string& prefix, uint64_t low, uint64_t high,
+                         uint64_t& value, bool& matched) {
+    if (arg.rfind(prefix, 0) != 0)
+        return true;
+    matched = true;
+    return parseNumber(arg.substr(prefix.size()), value) && value >= low && value <= high;
+}
+
+// Returns false on unknown options, bad values or missing arguments
+static bool parseOptions(int argc, char* argv[], GenOptions& options) {
+    vector<string> positional;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        uint64_t value = 0;
+        bool matched = false;
+        if (arg.rfind("--seed=", 0) == 0) {
+            if (!parseNumber(arg.substr(7), options.seed))
+                return false;
+            continue;
+        }
+        if (!parseBounded(arg, "--size=", 1, UINT32_MAX / 4, value, matched))
+            return false;
+        if (matched) { options.size = value; continue; }
+        if (!parseBounded(arg, "--depth=", 1, 8, value, matched))
+            return false;
+        if (matched) { options.depth = static_cast<unsigned>(value); continue; }
+        if (!parseBounded(arg, "--iterations=", 1, MAX_IMMEDIATE, value, matched))
+            return false;
+        if (matched) { options.iterations = static_cast<unsigned>(value); continue; }
+        if (!parseBounded(arg, "--body=", 1, 1000, value, matched))
+            return false;
+        if (matched) { options.body = static_cast<unsigned>(value); continue; }
+        if (!parseBounded(arg, "--count=", 1, MAX_IMMEDIATE, value, matched))
+            return false;
+        if (matched) { options.count = static_cast<unsigned>(value); continue; }
+        if (!parseBounded(arg, "--stride=", 0, MAX_IMMEDIATE, value, matched))
+            return false;
+        if (matched) { options.stride = static_cast<unsigned>(value); continue; }
+        if (!parseBounded(arg, "--sweeps=", 1, 1000000, value, matched))
+            return false;
+        if (matched) { options.sweeps = static_cast<unsigned>(value); continue; }
+        if (arg.rfind("--", 0) == 0)
+            return false;
+        positional.push_back(arg);
+    }
+    if (positional.size() != 2)
+        return false;
+
+    const string& kind = positional[0];
+    if (kind == "alu")
+        options.kind = WorkloadKind::Alu;
+    else if (kind == "loops")
+        options.kind = WorkloadKind::Loops;
+    else if (kind == "memory")
+        options.kind = WorkloadKind::Memory;
+    else if (kind == "labels")
+        options.kind = WorkloadKind::Labels;
+    else if (kind == "mixed")
+        options.kind = WorkloadKind::Mixed;
+    else
+        return false;
+    options.outputPath = positional[1];
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    GenOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    ofstream out(options.outputPath);
+    if (!out) {
+        cerr << "Error: Cannot open output file: " << options.outputPath << '\n';
+        return 1;
+    }
+
+    out << "# Generated by tiny_mips_gen, seed " << options.seed << '\n';
+    WorkloadWriter writer(out, options.seed);
+    bool all = options.kind == WorkloadKind::Mixed;
+    if (all || options.kind == WorkloadKind::Alu) {
+        writer.comment("Straight-line ALU block");
+        writer.alu(options.size);
+    }
+    if (all || options.kind == WorkloadKind::Loops) {
+        writer.comment("Loop nest, depth " + to_string(options.depth) + ", "
+                       + to_string(options.iterations) + " iteration(s) per level");
+        writer.addRetired(writer.loopNest(0, options.depth, options.iterations, options.body));
+    }
+    if (all || options.kind == WorkloadKind::Memory) {
+        writer.comment(to_string(options.sweeps) + " sweep(s) of " + to_string(options.count)
+                       + " word(s), stride " + to_string(options.stride));
+        for (unsigned i = 0; i < options.sweeps; ++i)
+            writer.sweep(options.count, options.stride);
+    }
+    if (all || options.kind == WorkloadKind::Labels) {
+        writer.comment("Label-dense block");
+        writer.labelDense(options.size);
+    }
+
+    string summary = to_string(writer.instructionCount()) + " instruction(s), "
+                     + to_string(writer.retiredCount()) + " retired when run";
+    out << "\n# " << summary << '\n';
+    out.close();
+    if (!out) {
+        cerr << "Error: Failed to write " << options.outputPath << '\n';
+        return 1;
+    }
+    cout << "Wrote " << options.outputPath << ": " << summary << '\n';
+    return 0;
+}
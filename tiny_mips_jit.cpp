@@ -0,0 +1,352 @@
+/*------------------------------------------------------------------------------
+  File:        tiny_mips_jit.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Basic-block JIT from decoded MIPS instructions to x86-64
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Host register use inside generated code:
+                 rbx = JitContext*, r12 = MIPS register file,
+                 r13 = retired count, r14 = budget
+               All four are callee-saved, so they survive the helper calls.
+               Guest register N lives at [r12 + 4*N].
+------------------------------------------------------------------------------*/
+
+#include "tiny_mips_jit.h"
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define TINY_MIPS_JIT_SUPPORTED 1
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+// Fixed field offsets used by the generated code
+static_assert(offsetof(JitContext, regs) == 0, "JitContext layout");
+static_assert(offsetof(JitContext, cpu) == 8, "JitContext layout");
+static_assert(offsetof(JitContext, retired) == 16, "JitContext layout");
+static_assert(offsetof(JitContext, budget) == 24, "JitContext layout");
+static_assert(offsetof(JitContext, exitPc) == 32, "JitContext layout");
+
+// Code cache size and the longest block we translate in one go
+static const size_t CODE_CACHE_BYTES = 4 * 1024 * 1024;
+static const uint32_t MAX_BLOCK_OPS = 256;
+// Upper bound on the bytes one translated instruction can take
+static const size_t MAX_BYTES_PER_OP = 48;
+
+// Host register numbers used in ModRM fields
+static const uint8_t EAX = 0;
+static const uint8_t EDX = 2;
+static const uint8_t ESI = 6;
+
+// Ops the JIT can translate; everything else is left to the interpreter
+static bool isSupported(OpHandler handler) {
+    return handler != OpHandler::UnknownR && handler != OpHandler::UnknownI;
+}
+
+TinyMipsJit::TinyMipsJit(TinyMipsCPU& cpu)
+    : cpu(cpu), codeBase(nullptr), codeCapacity(0), codeSize(0),
+      entryOffset(0), exitOffset(0), blockCount(0), writable(true) {
+#ifdef TINY_MIPS_JIT_SUPPORTED
+    // Mapped without PROT_EXEC; run() flips it before entering code
+    void* mapping = mmap(nullptr, CODE_CACHE_BYTES, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        return;
+    codeBase = static_cast<uint8_t*>(mapping);
+    codeCapacity = CODE_CACHE_BYTES;
+    codeSize = emitTrampolines();
+
+    size_t count = cpu.decodedProgram.size();
+    blockEntry.assign(count, -1);
+    blockLength.assign(count, 0);
+    pendingExits.assign(count, vector<size_t>());
+#endif
+}
+
+TinyMipsJit::~TinyMipsJit() {
+#ifdef TINY_MIPS_JIT_SUPPORTED
+    if (codeBase)
+        munmap(codeBase, codeCapacity);
+#endif
+}
+
+uint32_t TinyMipsJit::loadHelper(TinyMipsCPU* cpu, uint32_t address) {
+    return cpu->memory.loadWord(address);
+}
+
+void TinyMipsJit::storeHelper(TinyMipsCPU* cpu, uint32_t address, uint32_t value) {
+    cpu->memory.storeWord(address, value);
+}
+
+RunResult TinyMipsJit::run(uint64_t budget) {
+    JitContext context{cpu.registers.data(), &cpu, 0, budget, 0};
+    const size_t count = cpu.decodedProgram.size();
+#ifdef TINY_MIPS_JIT_SUPPORTED
+    using EntryFn = void (*)(JitContext*, const void*);
+    EntryFn enter = reinterpret_cast<EntryFn>(codeBase + entryOffset);
+#endif
+
+    while (true) {
+        // Budget is checked first so a run ending on a jump out of the
+        // program reports the limit the same way the interpreter does
+        if (context.retired >= budget)
+            return {StopReason::Budget, context.retired};
+
+        uint32_t pc = cpu.pc;
+        size_t index = pc / 4;
+        if (pc % 4 != 0 || index >= count)
+            return {StopReason::Halt, context.retired};
+
+        long entry = blockEntry[index];
+        if (entry < 0) {
+            entry = compileBlock(index);
+            if (entry < 0)
+                return {StopReason::Fault, context.retired};
+        }
+
+        // Too little budget for a whole block - finish in the interpreter
+        if (blockLength[index] > budget - context.retired) {
+            RunResult tail = cpu.runThreaded(budget - context.retired);
+            return {tail.reason, context.retired + tail.retired};
+        }
+
+#ifdef TINY_MIPS_JIT_SUPPORTED
+        makeExecutable();
+        enter(&context, codeBase + entry);
+#endif
+        cpu.pc = context.exitPc;
+    }
+}
+
+/*
+ * Entry: saves callee-saved registers, loads the context into rbx/r12-r14
+ * and jumps to the block in rsi. Exit: expects the next pc in eax, stores
+ * it with the retired count and returns to the dispatcher.
+ */
+size_t TinyMipsJit::emitTrampolines() {
+    codeSize = 0;
+    entryOffset = codeSize;
+    emit8(0x53);                                        // push rbx
+    emit8(0x41); emit8(0x54);                           // push r12
+    emit8(0x41); emit8(0x55);                           // push r13
+    emit8(0x41); emit8(0x56);                           // push r14
+    emit8(0x41); emit8(0x57);                           // push r15 (keeps rsp 16-byte aligned)
+    emit8(0x48); emit8(0x89); emit8(0xFB);              // mov rbx, rdi
+    emit8(0x4C); emit8(0x8B); emit8(0x63); emit8(0x00); // mov r12, [rbx+0]
+    emit8(0x4C); emit8(0x8B); emit8(0x6B); emit8(0x10); // mov r13, [rbx+16]
+    emit8(0x4C); emit8(0x8B); emit8(0x73); emit8(0x18); // mov r14, [rbx+24]
+    emit8(0xFF); emit8(0xE6);                           // jmp rsi
+
+    exitOffset = codeSize;
+    emit8(0x4C); emit8(0x89); emit8(0x6B); emit8(0x10); // mov [rbx+16], r13
+    emit8(0x89); emit8(0x43); emit8(0x20);              // mov [rbx+32], eax
+    emit8(0x41); emit8(0x5F);                           // pop r15
+    emit8(0x41); emit8(0x5E);                           // pop r14
+    emit8(0x41); emit8(0x5D);                           // pop r13
+    emit8(0x41); emit8(0x5C);                           // pop r12
+    emit8(0x5B);                                        // pop rbx
+    emit8(0xC3);                                        // ret
+    return codeSize;
+}
+
+long TinyMipsJit::compileBlock(size_t index) {
+    const vector<DecodedOp>& ops = cpu.decodedProgram;
+    const size_t count = ops.size();
+
+    // Scan forward to the terminator, the next unsupported op or the cap
+    uint32_t length = 0;
+    while (index + length < count && length < MAX_BLOCK_OPS) {
+        OpHandler handler = ops[index + length].handler;
+        if (!isSupported(handler))
+            break;
+        ++length;
+        if (handler == OpHandler::Beq || handler == OpHandler::J)
+            break;
+    }
+    if (length == 0)
+        return -1;
+
+    // Emitting, flushing and linking pending exits all write the cache
+    makeWritable();
+    size_t needed = 64 + length * MAX_BYTES_PER_OP;
+    if (codeSize + needed > codeCapacity)
+        flush();
+
+    const long entry = static_cast<long>(codeSize);
+    const uint32_t blockPc = static_cast<uint32_t>(index * 4);
+
+    // Budget check: exit back to the dispatcher if the block would overrun
+    emit8(0x49); emit8(0x8D); emit8(0x85); emit32(length); // lea rax, [r13+length]
+    emit8(0x4C); emit8(0x39); emit8(0xF0);                 // cmp rax, r14
+    emit8(0x76); emit8(0x0A);                              // jbe +10
+    emit8(0xB8); emit32(blockPc);                          // mov eax, blockPc
+    emit8(0xE9); emit32(static_cast<uint32_t>(exitOffset - (codeSize + 4))); // jmp exit
+    emit8(0x49); emit8(0x89); emit8(0xC5);                 // mov r13, rax
+
+    for (uint32_t i = 0; i < length; ++i) {
+        const DecodedOp& op = ops[index + i];
+        switch (op.handler) {
+            case OpHandler::Add:
+            case OpHandler::Sub:
+            case OpHandler::And:
+            case OpHandler::Or:
+            case OpHandler::Nor: {
+                static const uint8_t aluOpcode[] = {0x03, 0x2B, 0x23, 0x0B, 0x0B};
+                emitRegOp(0x8B, EAX, op.rs);
+                emitRegOp(aluOpcode[static_cast<size_t>(op.handler)], EAX, op.rt);
+                if (op.handler == OpHandler::Nor) {
+                    emit8(0xF7); emit8(0xD0);                   // not eax
+                }
+                emitRegOp(0x89, EAX, op.rd);
+                break;
+            }
+            case OpHandler::Slt:
+                emit8(0x31); emit8(0xC9);                       // xor ecx, ecx
+                emitRegOp(0x8B, EAX, op.rs);
+                emitRegOp(0x3B, EAX, op.rt);                    // cmp eax, [rt]
+                emit8(0x0F); emit8(0x9C); emit8(0xC1);          // setl cl
+                emitRegOp(0x89, 1, op.rd);                      // mov [rd], ecx
+                break;
+            case OpHandler::Addi:
+                emitRegOp(0x8B, EAX, op.rs);
+                emit8(0x05); emit32(static_cast<uint32_t>(op.imm)); // add eax, imm
+                emitRegOp(0x89, EAX, op.rt);
+                break;
+            case OpHandler::Lw:
+                emitRegOp(0x8B, ESI, op.rs);
+                emit8(0x81); emit8(0xC6); emit32(static_cast<uint32_t>(op.imm)); // add esi, imm
+                emit8(0x48); emit8(0x8B); emit8(0x7B); emit8(0x08); // mov rdi, [rbx+8]
+                emitCall(reinterpret_cast<const void*>(&TinyMipsJit::loadHelper));
+                emitRegOp(0x89, EAX, op.rt);
+                break;
+            case OpHandler::Sw:
+                emitRegOp(0x8B, ESI, op.rs);
+                emit8(0x81); emit8(0xC6); emit32(static_cast<uint32_t>(op.imm)); // add esi, imm
+                emitRegOp(0x8B, EDX, op.rt);
+                emit8(0x48); emit8(0x8B); emit8(0x7B); emit8(0x08); // mov rdi, [rbx+8]
+                emitCall(reinterpret_cast<const void*>(&TinyMipsJit::storeHelper));
+                break;
+            case OpHandler::Beq: {
+                emitRegOp(0x8B, EAX, op.rs);
+                emitRegOp(0x3B, EAX, op.rt);
+                emit8(0x0F); emit8(0x85);                       // jne not_taken
+                size_t notTaken = codeSize;
+                emit32(0);
+                emitExit(op.target);
+                patch32(notTaken, static_cast<uint32_t>(codeSize - (notTaken + 4)));
+                emitExit(blockPc + (i + 1) * 4);
+                break;
+            }
+            case OpHandler::J:
+                emitExit(op.target);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Blocks cut short by an unsupported op or the cap fall through
+    OpHandler last = ops[index + length - 1].handler;
+    if (last != OpHandler::Beq && last != OpHandler::J)
+        emitExit(blockPc + length * 4);
+
+    blockEntry[index] = entry;
+    blockLength[index] = length;
+    ++blockCount;
+    linkPending(index, static_cast<size_t>(entry));
+    return entry;
+}
+
+void TinyMipsJit::emitExit(uint32_t targetPc) {
+    emit8(0xB8); emit32(targetPc);                      // mov eax, targetPc
+    emit8(0xE9);                                        // jmp rel32
+    size_t rel = codeSize;
+    emit32(0);
+
+    size_t targetIndex = targetPc / 4;
+    bool inProgram = targetPc % 4 == 0 && targetIndex < blockEntry.size();
+    if (inProgram && blockEntry[targetIndex] >= 0) {
+        // Chain straight into the already compiled block
+        patch32(rel, static_cast<uint32_t>(blockEntry[targetIndex] - static_cast<long>(rel + 4)));
+        return;
+    }
+    patch32(rel, static_cast<uint32_t>(exitOffset - (rel + 4)));
+    if (inProgram)
+        pendingExits[targetIndex].push_back(rel);
+}
+
+void TinyMipsJit::linkPending(size_t targetIndex, size_t entryOffset) {
+    for (size_t rel : pendingExits[targetIndex])
+        patch32(rel, static_cast<uint32_t>(entryOffset - (rel + 4)));
+    pendingExits[targetIndex].clear();
+}
+
+void TinyMipsJit::flush() {
+    codeSize = emitTrampolines();
+    blockEntry.assign(blockEntry.size(), -1);
+    blockLength.assign(blockLength.size(), 0);
+    for (auto& pending : pendingExits)
+        pending.clear();
+    blockCount = 0;
+}
+
+void TinyMipsJit::makeWritable() {
+#ifdef TINY_MIPS_JIT_SUPPORTED
+    if (writable)
+        return;
+    if (mprotect(codeBase, codeCapacity, PROT_READ | PROT_WRITE) != 0)
+        throw runtime_error("Cannot make the JIT code cache writable");
+    writable = true;
+#endif
+}
+
+void TinyMipsJit::makeExecutable() {
+#ifdef TINY_MIPS_JIT_SUPPORTED
+    if (!writable)
+        return;
+    if (mprotect(codeBase, codeCapacity, PROT_READ | PROT_EXEC) != 0)
+        throw runtime_error("Cannot make the JIT code cache executable");
+    writable = false;
+#endif
+}
+
+void TinyMipsJit::emit8(uint8_t value) {
+    codeBase[codeSize++] = value;
+}
+
+void TinyMipsJit::emit32(uint32_t value) {
+    memcpy(codeBase + codeSize, &value, 4);
+    codeSize += 4;
+}
+
+void TinyMipsJit::emit64(uint64_t value) {
+    memcpy(codeBase + codeSize, &value, 8);
+    codeSize += 8;
+}
+
+void TinyMipsJit::patch32(size_t offset, uint32_t value) {
+    memcpy(codeBase + offset, &value, 4);
+}
+
+// <opcode> hostReg, [r12 + 4*mipsReg] (or the store form for opcode 0x89)
+void TinyMipsJit::emitRegOp(uint8_t opcode, uint8_t hostReg, uint8_t mipsReg) {
+    emit8(0x41);
+    emit8(opcode);
+    emit8(static_cast<uint8_t>(0x44 | (hostReg << 3)));
+    emit8(0x24);
+    emit8(static_cast<uint8_t>(mipsReg * 4));
+}
+
+void TinyMipsJit::emitCall(const void* function) {
+    emit8(0x48); emit8(0xB8);                           // mov rax, imm64
+    emit64(reinterpret_cast<uint64_t>(function));
+    emit8(0xFF); emit8(0xD0);                           // call rax
+}
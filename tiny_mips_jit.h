@@ -0,0 +1,122 @@
+/*------------------------------------------------------------------------------
+  File:        tiny_mips_jit.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares the basic-block JIT that translates decoded MIPS
+               instructions into native x86-64 code.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               A basic block starts at any pc the dispatcher asks for and
+               runs up to and including the next beq or j. Supported ops are
+               add, sub, and, or, nor, slt, addi, lw, sw, beq and j. A block
+               ends early in front of anything else, and the CPU interpreter
+               executes that instruction instead.
+
+               Block exits are emitted as "mov eax, pc; jmp exit" stubs. Once
+               the target block is compiled the jmp is patched to go straight
+               to it, so hot loops run without returning to C++. Each block
+               checks the step budget on entry and exits if it would overrun.
+
+               Loads and stores call back into the CPU's PagedMemory so the
+               JIT shares the interpreter's memory model.
+
+               The code cache is never writable and executable at once: it
+               is read/write while a block is emitted or an exit patched,
+               and read/execute whenever generated code runs.
+               Only x86-64 Linux is supported; elsewhere available() is false
+               and the CPU falls back to the threaded interpreter.
+
+  Dependencies:
+    - tiny_mips_cpu.h
+    - <cstdint>, <cstddef>, <vector>
+  -----------------------------------------------------------------------------*/
+#ifndef TINY_MIPS_JIT_H
+#define TINY_MIPS_JIT_H
+
+#include "tiny_mips_cpu.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// State shared between the dispatcher and generated code (offsets are fixed)
+struct JitContext {
+    // +0  register file of the CPU being run
+    uint32_t* regs;
+    // +8  CPU passed to the load/store helpers
+    TinyMipsCPU* cpu;
+    // +16 instructions retired so far
+    uint64_t retired;
+    // +24 retire limit for this run
+    uint64_t budget;
+    // +32 pc to continue from when generated code exits
+    uint32_t exitPc;
+};
+
+class TinyMipsJit {
+public:
+    explicit TinyMipsJit(TinyMipsCPU& cpu);
+    ~TinyMipsJit();
+
+    TinyMipsJit(const TinyMipsJit&) = delete;
+    TinyMipsJit& operator=(const TinyMipsJit&) = delete;
+
+    // True when the host supports the JIT and the code cache was mapped
+    bool available() const { return codeBase != nullptr; }
+
+    // Runs at most budget instructions from the CPU's pc (same contract as
+    // TinyMipsCPU::runThreaded)
+    RunResult run(uint64_t budget);
+
+    // Number of blocks compiled since the cache was last flushed
+    size_t compiledBlocks() const { return blockCount; }
+
+private:
+    // Compiles the block starting at instruction index, or returns -1 when
+    // its first instruction is not supported
+    long compileBlock(size_t index);
+    // Emits "mov eax, targetPc; jmp ..." and links it to the target if known
+    void emitExit(uint32_t targetPc);
+    // Points every pending exit for targetIndex at the new block entry
+    void linkPending(size_t targetIndex, size_t entryOffset);
+    // Drops every compiled block (used when the cache is full)
+    void flush();
+    size_t emitTrampolines();
+
+    void emit8(uint8_t value);
+    void emit32(uint32_t value);
+    void emit64(uint64_t value);
+    void patch32(size_t offset, uint32_t value);
+    void emitRegOp(uint8_t opcode, uint8_t hostReg, uint8_t mipsReg);
+    void emitCall(const void* function);
+    // Switch the code cache between read/write and read/execute
+    // (no system call if it is already in that state)
+    void makeWritable();
+    void makeExecutable();
+
+    // Called from generated code for lw/sw
+    static uint32_t loadHelper(TinyMipsCPU* cpu, uint32_t address);
+    static void storeHelper(TinyMipsCPU* cpu, uint32_t address, uint32_t value);
+
+    TinyMipsCPU& cpu;
+    uint8_t* codeBase;
+    size_t codeCapacity;
+    size_t codeSize;
+    // Offsets of the entry trampoline and the shared exit stub
+    size_t entryOffset;
+    size_t exitOffset;
+    // Code offset of each compiled block by instruction index (-1 if none)
+    std::vector<long> blockEntry;
+    // Instruction count of each compiled block by instruction index
+    std::vector<uint32_t> blockLength;
+    // rel32 fields still pointing at the exit stub, by target index
+    std::vector<std::vector<size_t>> pendingExits;
+    size_t blockCount;
+    // True while the cache is mapped read/write (and not executable)
+    bool writable;
+};
+
+#endif // TINY_MIPS_JIT_H
@@ -0,0 +1,164 @@
+/*------------------------------------------------------------------------------
+  File:        tiny_mips_trace.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Offline decoder for binary retire traces written by
+               simulate_single_cpu --retire-trace. Prints the records in the
+               same one-line format as --trace=changed, optionally filtered.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - retire_trace.h: trace reader and record formatting
+    - trace_sink.h: buffered stdout
+    - converters.h: register name lookup for --reg
+  -----------------------------------------------------------------------------*/
+#include "retire_trace.h"
+#include "trace_sink.h"
+#include "converters.h"
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace std;
+
+// Which records are printed (all of them by default)
+struct TraceFilter {
+    uint32_t pcStart = 0;
+    uint32_t pcEnd = UINT32_MAX;
+    // Register that must be written, or -1 for any
+    int destReg = -1;
+    bool memoryOnly = false;
+    bool branchesOnly = false;
+    // Stop after this many matches (0 = no limit)
+    uint64_t limit = 0;
+    bool countOnly = false;
+};
+
+static void printUsage() {
+    cerr << "Usage: ./tiny_mips_trace [options] <trace_file>\n"
+         << "  --pc=START[:END]  Only instructions with START <= pc <= END\n"
+         << "  --reg=REG         Only instructions that write REG ($t0 or $8)\n"
+         << "  --mem             Only lw/sw\n"
+         << "  --branches        Only beq/j\n"
+         << "  --limit=N         Stop after N matching records\n"
+         << "  --count           Print the number of matching records only\n";
+}
+
+// Accepts decimal or 0x-prefixed hex
+static bool parseNumber(const string& text, uint64_t& value) {
+    if (text.empty())
+        return false;
+    char* end = nullptr;
+    value = strtoull(text.c_str(), &end, 0);
+    return *end == '\0';
+}
+
+// Accepts "$t0" style names and "$8" style numbers
+static bool parseRegister(const string& text, int& reg) {
+    uint64_t number;
+    if (text.size() > 1 && text[0] == '$' && parseNumber(text.substr(1), number)) {
+        if (number > 31)
+            return false;
+        reg = static_cast<int>(number);
+        return true;
+    }
+    try {
+        reg = reg_number(text);
+    } catch (const runtime_error&) {
+        return false;
+    }
+    return true;
+}
+
+// Returns false on unknown options or a missing trace path
+static bool parseOptions(int argc, char* argv[], TraceFilter& filter, string& path) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        uint64_t number;
+        if (arg == "--mem") {
+            filter.memoryOnly = true;
+        } else if (arg == "--branches") {
+            filter.branchesOnly = true;
+        } else if (arg == "--count") {
+            filter.countOnly = true;
+        } else if (arg.rfind("--limit=", 0) == 0) {
+            if (!parseNumber(arg.substr(8), filter.limit))
+                return false;
+        } else if (arg.rfind("--reg=", 0) == 0) {
+            if (!parseRegister(arg.substr(6), filter.destReg))
+                return false;
+        } else if (arg.rfind("--pc=", 0) == 0) {
+            string range = arg.substr(5);
+            size_t colon = range.find(':');
+            if (!parseNumber(range.substr(0, colon), number))
+                return false;
+            filter.pcStart = static_cast<uint32_t>(number);
+            filter.pcEnd = filter.pcStart;
+            if (colon != string::npos) {
+                if (!parseNumber(range.substr(colon + 1), number))
+                    return false;
+                filter.pcEnd = static_cast<uint32_t>(number);
+            }
+        } else if (arg.rfind("--", 0) == 0 || !path.empty()) {
+            return false;
+        } else {
+            path = arg;
+        }
+    }
+    return !path.empty();
+}
+
+static bool matches(const TraceFilter& filter, const RetireRecord& record) {
+    if (record.pc < filter.pcStart || record.pc > filter.pcEnd)
+        return false;
+    if (filter.destReg >= 0 && record.destReg != filter.destReg)
+        return false;
+    if (filter.memoryOnly && !(record.flags & (RETIRE_MEM_READ | RETIRE_MEM_WRITE)))
+        return false;
+    if (filter.branchesOnly) {
+        uint32_t opcode = record.instruction >> 26;
+        if (opcode != 0x02 && opcode != 0x03 && opcode != 0x04)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    TraceFilter filter;
+    string path;
+    if (!parseOptions(argc, argv, filter, path)) {
+        printUsage();
+        return 1;
+    }
+
+    TraceSink& sink = TraceSink::standardOutput();
+    ostream& out = sink.out();
+    uint64_t matched = 0;
+    try {
+        RetireTraceReader reader(path);
+        RetireRecord record;
+        while (reader.next(record)) {
+            if (!matches(filter, record))
+                continue;
+            ++matched;
+            if (!filter.countOnly)
+                out << formatRetireRecord(record) << '\n';
+            if (matched == filter.limit)
+                break;
+        }
+    } catch (const exception& e) {
+        sink.flush();
+        cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+
+    if (filter.countOnly)
+        out << matched << '\n';
+    sink.flush();
+    return 0;
+}
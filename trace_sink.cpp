@@ -0,0 +1,98 @@
+/*------------------------------------------------------------------------------
+  File:        trace_sink.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Implements the buffered trace sink used by the CPU simulator
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+------------------------------------------------------------------------------*/
+
+#include "trace_sink.h"
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+
+using namespace std;
+
+bool parseTraceLevel(const string& name, TraceLevel& level) {
+    if (name == "none")         level = TraceLevel::None;
+    else if (name == "summary") level = TraceLevel::Summary;
+    else if (name == "changed") level = TraceLevel::Changed;
+    else if (name == "full")    level = TraceLevel::Full;
+    else return false;
+    return true;
+}
+
+TraceSink::Buffer::Buffer(int fd, size_t bytes)
+    : fd(fd), storage(bytes) {
+    setp(storage.data(), storage.data() + storage.size());
+}
+
+// Writes the buffered bytes to the descriptor and resets the put area
+bool TraceSink::Buffer::drain() {
+    const char* data = pbase();
+    size_t remaining = static_cast<size_t>(pptr() - pbase());
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            setp(storage.data(), storage.data() + storage.size());
+            return false;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    setp(storage.data(), storage.data() + storage.size());
+    return true;
+}
+
+TraceSink::Buffer::int_type TraceSink::Buffer::overflow(int_type ch) {
+    if (!drain())
+        return traits_type::eof();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+streamsize TraceSink::Buffer::xsputn(const char* data, streamsize count) {
+    streamsize copied = 0;
+    while (copied < count) {
+        streamsize room = epptr() - pptr();
+        if (room == 0) {
+            if (!drain())
+                break;
+            continue;
+        }
+        streamsize chunk = min(room, count - copied);
+        memcpy(pptr(), data + copied, static_cast<size_t>(chunk));
+        pbump(static_cast<int>(chunk));
+        copied += chunk;
+    }
+    return copied;
+}
+
+int TraceSink::Buffer::sync() {
+    return drain() ? 0 : -1;
+}
+
+TraceSink::TraceSink(int fd, size_t bufferBytes)
+    : buffer(fd, bufferBytes), stream(&buffer) { }
+
+TraceSink::~TraceSink() {
+    flush();
+}
+
+void TraceSink::flush() {
+    stream.flush();
+}
+
+TraceSink& TraceSink::standardOutput() {
+    static TraceSink sink(1);
+    return sink;
+}
@@ -0,0 +1,87 @@
+/*------------------------------------------------------------------------------
+  File:        trace_sink.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project (Bonus)
+  Purpose:     Declares trace verbosity levels and the buffered sink that all
+               simulator trace output is written through.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               TraceSink wraps a std::ostream around a large fixed buffer that
+               is written to a file descriptor only when full or on flush(),
+               instead of once per std::endl. Stream formatting state (hex,
+               setw, setfill) behaves exactly like std::cout.
+
+  Dependencies:
+    - <ostream>, <streambuf>, <vector>, <string>
+  -----------------------------------------------------------------------------*/
+#ifndef TRACE_SINK_H
+#define TRACE_SINK_H
+
+#include <ostream>
+#include <streambuf>
+#include <vector>
+#include <string>
+
+// How much the simulator reports while it runs
+enum class TraceLevel {
+    // No trace output at all
+    None,
+    // Final state and instruction count only
+    Summary,
+    // One line per instruction with the register or memory it changed
+    Changed,
+    // Full per-instruction dump (binary, fields, register file, memory)
+    Full
+};
+
+/**
+ * Parses "none", "summary", "changed" or "full".
+ *
+ * @param name  - Level name from the command line
+ * @param level - Set to the parsed level on success
+ * @return true if the name was recognized
+ */
+bool parseTraceLevel(const std::string& name, TraceLevel& level);
+
+class TraceSink {
+public:
+    // Writes to the given file descriptor (stdout by default)
+    explicit TraceSink(int fd = 1, size_t bufferBytes = 1 << 16);
+    ~TraceSink();
+
+    TraceSink(const TraceSink&) = delete;
+    TraceSink& operator=(const TraceSink&) = delete;
+
+    // Stream used for all formatted trace output
+    std::ostream& out() { return stream; }
+    // Writes everything buffered so far
+    void flush();
+
+    // Shared sink on stdout used by CPUs that were not given one
+    static TraceSink& standardOutput();
+
+private:
+    class Buffer : public std::streambuf {
+    public:
+        Buffer(int fd, size_t bytes);
+        bool drain();
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* data, std::streamsize count) override;
+        int sync() override;
+
+    private:
+        int fd;
+        std::vector<char> storage;
+    };
+
+    Buffer buffer;
+    std::ostream stream;
+};
+
+#endif // TRACE_SINK_H
@@ -0,0 +1,89 @@
+/*------------------------------------------------------------------------------
+  File:        work_pool.cpp
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Implements the work-stealing loop over per-thread deques.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Dependencies:
+    - work_pool.h
+    - <deque>, <mutex>, <thread>, <vector>, <exception>, <algorithm>
+  -----------------------------------------------------------------------------*/
+#include "work_pool.h"
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+using namespace std;
+
+// Task indices owned by one worker
+struct WorkQueue {
+    mutex lock;
+    deque<size_t> tasks;
+};
+
+// Owner side: next task in order
+static bool takeOwn(WorkQueue& queue, size_t& task) {
+    lock_guard<mutex> guard(queue.lock);
+    if (queue.tasks.empty())
+        return false;
+    task = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+// Thief side: the task the owner would reach last
+static bool steal(WorkQueue& queue, size_t& task) {
+    lock_guard<mutex> guard(queue.lock);
+    if (queue.tasks.empty())
+        return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+void runWorkStealing(size_t count, unsigned threads, const function<void(size_t)>& task) {
+    size_t workers = min<size_t>(max(threads, 1u), count);
+    if (workers == 0)
+        return;
+
+    // Contiguous blocks, so each worker walks its share in order
+    vector<WorkQueue> queues(workers);
+    for (size_t i = 0; i < count; ++i)
+        queues[i * workers / count].tasks.push_back(i);
+
+    vector<exception_ptr> errors(count);
+    auto worker = [&](size_t self) {
+        size_t index;
+        for (;;) {
+            bool found = takeOwn(queues[self], index);
+            for (size_t k = 1; !found && k < workers; ++k)
+                found = steal(queues[(self + k) % workers], index);
+            if (!found)
+                return;
+            try {
+                task(index);
+            } catch (...) {
+                errors[index] = current_exception();
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (size_t t = 1; t < workers; ++t)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for (thread& t : pool)
+        t.join();
+
+    for (const exception_ptr& error : errors) {
+        if (error)
+            rethrow_exception(error);
+    }
+}
@@ -0,0 +1,41 @@
+/*------------------------------------------------------------------------------
+  File:        work_pool.h
+  Project:     Tiny MIPS Assembler - CSCE 5610 Group Project
+  Purpose:     Declares the work-stealing loop used to run many independent
+               jobs (one per file) across a fixed number of threads.
+
+  Authors:     Souban Ahmed, Bhargav Alimili, Bob Jack, Janaki Ramaiah Venigalla
+  Group:       CSCE5610 - Group 2
+  Instructor:  Dr. Beilei Jiang
+  Date:        July 2025
+
+  Description:
+               Every worker starts with its own contiguous block of task
+               indices in a deque. It takes work from the front of its own
+               deque and, once that is empty, steals from the back of the
+               other workers' deques, so a few slow tasks (large files) do
+               not leave the rest of the threads idle. No tasks are added
+               while running, so a worker stops once every deque is empty.
+
+  Dependencies:
+    - <functional>, <cstddef>
+  -----------------------------------------------------------------------------*/
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <functional>
+#include <cstddef>
+
+/**
+ * Runs task(i) once for every i in [0, count) on up to threads threads
+ * (the calling thread is one of them).
+ *
+ * @param count   - Number of tasks
+ * @param threads - Worker threads to use (at least 1)
+ * @param task    - Called with each task index; may run concurrently
+ * @throws Whatever the lowest-numbered failing task threw, after every
+ *         task has run
+ */
+void runWorkStealing(size_t count, unsigned threads, const std::function<void(size_t)>& task);
+
+#endif // WORK_POOL_H